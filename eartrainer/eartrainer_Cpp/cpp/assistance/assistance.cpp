@@ -4,11 +4,11 @@
 
 #include <algorithm>
 #include <array>
-#include <cctype>
 #include <cmath>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ear::assistance {
@@ -31,14 +31,16 @@ MidiClip make_scale_arpeggio_clip(const SessionSpec& spec) {
   MidiClipBuilder builder(tempo, 480);
   const auto track = builder.add_track("scale", 0, 0);
 
-  const std::vector<int> pattern = {0, 1, 2, 3, 4, 5, 6, 7, 4, 2, 0};
+  // Degree patterns are fixed, so they live in constexpr arrays instead of a
+  // heap-backed vector rebuilt per call; degree_to_offset itself is already
+  // an inline table lookup, so the per-degree work is one add.
+  static constexpr std::array<int, 11> kPattern = {0, 1, 2, 3, 4, 5, 6, 7, 4, 2, 0};
   const int tonic = drills::central_tonic_midi(spec.key);
 
   Beats beat{0.0};
-  for (std::size_t i = 0; i < pattern.size(); ++i) {
-    int degree = pattern[i];
-    int midi = tonic + drills::degree_to_offset(degree);
-    const double dur = (i == pattern.size() - 1) ? 1.08 : 0.72;
+  for (std::size_t i = 0; i < kPattern.size(); ++i) {
+    int midi = tonic + drills::degree_to_offset(kPattern[i]);
+    const double dur = (i == kPattern.size() - 1) ? 1.08 : 0.72;
     builder.add_note(track, beat, Beats{dur}, midi, std::nullopt);
     beat.advance_by(dur);
   }
@@ -50,14 +52,13 @@ MidiClip make_scale_clip(const SessionSpec& spec) {
   MidiClipBuilder builder(tempo, 480);
   const auto track = builder.add_track("scale", 0, 0);
 
-  const std::vector<int> pattern = {0, 1, 2, 3, 4, 5, 6, 7};
+  static constexpr std::array<int, 8> kPattern = {0, 1, 2, 3, 4, 5, 6, 7};
   const int tonic = drills::central_tonic_midi(spec.key);
 
   Beats beat{0.0};
-  for (std::size_t i = 0; i < pattern.size(); ++i) {
-    int degree = pattern[i];
-    int midi = tonic + drills::degree_to_offset(degree);
-    const double dur = (i == pattern.size() - 1) ? 1.08 : 0.72;
+  for (std::size_t i = 0; i < kPattern.size(); ++i) {
+    int midi = tonic + drills::degree_to_offset(kPattern[i]);
+    const double dur = (i == kPattern.size() - 1) ? 1.08 : 0.72;
     builder.add_note(track, beat, Beats{dur}, midi, std::nullopt);
     beat.advance_by(dur);
   }
@@ -69,8 +70,7 @@ MidiClip make_cadence_clip(const SessionSpec& spec) {
   MidiClipBuilder builder(tempo, 480);
   const auto track = builder.add_track("cadence", 0, 0);
 
-  const std::vector<int> pattern = {0, 1, 2, 3, 4, 5, 6, 7};
-  const std::vector<std::vector<int>> cadence = {
+  static const std::vector<std::vector<int>> cadence = {
     {-14, -7, 0},                // C2-C3-C4
     {-11, -4, 1, 3, 7},          // F2-F3-D4-A4-C5
     {-10, -3, 2, 4, 7},          // G2-G3-E4-G4-C5
@@ -80,7 +80,7 @@ MidiClip make_cadence_clip(const SessionSpec& spec) {
   const int tonic = drills::central_tonic_midi(spec.key);
 
   Beats beat{0.0};
-  for (std::vector<int> chord : cadence) {
+  for (const std::vector<int>& chord : cadence) {
     std::vector<int> chord_midis; 
     chord_midis.reserve(chord.size());
     for (int degree : chord) {
@@ -94,31 +94,57 @@ MidiClip make_cadence_clip(const SessionSpec& spec) {
 }
 
 
-std::string normalize_kind(const std::string& kind) {
-  std::string normalized;
-  normalized.reserve(kind.size());
+// Assist kinds are ASCII by construction, so classification is plain range
+// arithmetic rather than the locale-dispatching std::isalnum/std::tolower
+// pair. Returns the lowercased character, or 0 for separators/punctuation,
+// which the matcher skips.
+constexpr char ascii_normalized(char ch) {
+  if ((ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9')) {
+    return ch;
+  }
+  if (ch >= 'A' && ch <= 'Z') {
+    return static_cast<char>(ch - 'A' + 'a');
+  }
+  return 0;
+}
+
+// Case- and punctuation-insensitive match against a registry token, walking
+// the caller's spelling ("ScaleArpeggio", "scale_arpeggio") in place. The old
+// path heap-built a lowercased copy of the kind for every call; with four
+// closed-set tokens a streaming compare needs no allocation and no cache.
+bool kind_matches(std::string_view kind, std::string_view token) {
+  std::size_t ti = 0;
   for (char ch : kind) {
-    if (std::isalnum(static_cast<unsigned char>(ch))) {
-      normalized.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
+    const char lowered = ascii_normalized(ch);
+    if (lowered == 0) {
+      continue;
+    }
+    if (ti == token.size() || lowered != token[ti]) {
+      return false;
     }
+    ++ti;
   }
-  return normalized;
+  return ti == token.size();
 }
 
-const std::array<std::pair<const char*, MidiClip (*)(const SessionSpec&)>, 4>& registry() {
-  static const std::array<std::pair<const char*, MidiClip (*)(const SessionSpec&)>, 4> defs = {{
-      {"tonic", &make_tonic_clip},
-      {"scalearpeggio", &make_scale_arpeggio_clip},
-      {"scale", &make_scale_clip},
-      {"cadence", &make_cadence_clip},
-  }};
-  return defs;
+// The assist-kind set is closed, so the table is a constexpr array of
+// function pointers resolved at compile time - no static-init guard on
+// access and nothing per-session to build.
+constexpr std::array<std::pair<const char*, MidiClip (*)(const SessionSpec&)>, 4> kRegistry = {{
+    {"tonic", &make_tonic_clip},
+    {"scalearpeggio", &make_scale_arpeggio_clip},
+    {"scale", &make_scale_clip},
+    {"cadence", &make_cadence_clip},
+}};
+
+constexpr const std::array<std::pair<const char*, MidiClip (*)(const SessionSpec&)>, 4>&
+registry() {
+  return kRegistry;
 }
 
 MidiClip dispatch_clip(const SessionSpec& spec, const std::string& kind) {
-  const auto normalized = normalize_kind(kind);
   for (const auto& [token, factory] : registry()) {
-    if (normalized == token) {
+    if (kind_matches(kind, token)) {
       return factory(spec);
     }
   }
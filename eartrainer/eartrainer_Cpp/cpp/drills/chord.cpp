@@ -150,9 +150,9 @@ std::vector<int> absolute_degrees(int root_degree, const std::vector<int>& offse
 //====================================================================
 void ChordDrill::configure(const DrillSpec& spec) {
   spec_ = spec;
-  try {
-    params = std::get<ChordParams>(spec_.params);
-  } catch (const std::bad_variant_access&) {
+  if (const auto* p = std::get_if<ChordParams>(&spec_.params)) {
+    params = *p;
+  } else {
     throw std::runtime_error("ChordDrill: spec '" + spec_.id + "' missing chord params");
   }
   if (params.use_anchor && params.play_root.enabled) {
@@ -92,9 +92,9 @@ std::vector<Pattern> build_patterns(const std::vector<int>& cluster_ids) {
 //====================================================================
 void HarmonyDrill::configure(const DrillSpec& spec) {
   spec_ = spec;
-  try {
-    params = std::get<IntervalParams>(spec_.params);
-  } catch (const std::bad_variant_access&) {
+  if (const auto* p = std::get_if<IntervalParams>(&spec_.params)) {
+    params = *p;
+  } else {
     throw std::runtime_error("HarmonyDrill: spec '" + spec_.id + "' missing interval params");
   }
   tonic_midi_ = drills::central_tonic_midi(spec_.key);
@@ -58,9 +58,9 @@ std::string get_interval_name(int semitones) {
 
 void IntervalDrill::configure(const DrillSpec& spec) {
   spec_ = spec;
-  try {
-    params = std::get<IntervalParams>(spec.params);
-  } catch (const std::bad_variant_access&) {
+  if (const auto* p = std::get_if<IntervalParams>(&spec.params)) {
+    params = *p;
+  } else {
     throw std::runtime_error("IntervalDrill: spec '" + spec.id + "' missing interval params");
   }
   last_bottom_degree_.reset();
@@ -236,9 +236,9 @@ std::vector<int> degrees_to_midi(
 //====================================================================
 void MelodyDrill::configure(const DrillSpec& spec) {
   spec_ = spec;
-  try {
-    params = std::get<MelodyParams>(spec_.params);
-  } catch (const std::bad_variant_access&) {
+  if (const auto* p = std::get_if<MelodyParams>(&spec_.params)) {
+    params = *p;
+  } else {
     throw std::runtime_error("MelodyDrill: spec '" + spec_.id + "' missing melody params");
   }
   tonic_midi = drills::central_tonic_midi(spec_.key);
@@ -310,6 +310,7 @@ QuestionBundle MelodyDrill::next_question(std::uint64_t& rng_state) {
   //-----------------------------------------------------------------
   MidiClipBuilder b(params.bpm, 480);
   auto melody_track = b.add_track("melody", 0, params.program);
+  b.reserve_notes(melody_track, midis.size());
 
   Beats beat = Beats{0}; // CURRENT BEAT
   for (int midi : midis){
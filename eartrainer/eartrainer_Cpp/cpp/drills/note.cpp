@@ -93,9 +93,9 @@ std::vector<int> get_pathway_midi (int degree, int midi, int tonic_midi, bool in
 //====================================================================
 void NoteDrill::configure(const DrillSpec& spec) {
   spec_ = spec;
-  try {
-    params = std::get<NoteParams>(spec_.params);
-  } catch (const std::bad_variant_access&) {
+  if (const auto* p = std::get_if<NoteParams>(&spec_.params)) {
+    params = *p;
+  } else {
     throw std::runtime_error("NoteDrill: spec '" + spec_.id + "' missing note params");
   }
   last_degree_.reset();
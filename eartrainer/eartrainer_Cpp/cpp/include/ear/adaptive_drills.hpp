@@ -23,11 +23,13 @@ public:
   //-----------------------------------------------------------------
   // AUXILIARY STRUCS
   //-----------------------------------------------------------------
+  // Deliberately just the pointer and index: callers only ever read those two
+  // fields, and the weight/level vectors the selection produced live on in
+  // last_track_weights_/last_track_levels_ for diagnostics, so carrying copies
+  // here too would only add per-pick allocations.
   struct TrackPick {
     const resources::ManifestView::Lesson* node = nullptr;
     int track_index = -1;
-    std::vector<int> weights;
-    std::vector<int> normalized_levels;
   };
   struct ScoreSnapshot {
     double bout_average = 0.0;
@@ -171,7 +173,7 @@ private:
   int current_track_index_ = -1;
   std::vector<int> last_track_levels_;
   std::vector<int> last_track_weights_;
-  std::optional<resources::ManifestView::TrackPick> last_track_pick_;
+  std::optional<TrackPick> last_track_pick_;
   std::unordered_map<std::string, std::size_t> question_slot_index_;
   
   // Bout accumulation (for reporting only)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -158,7 +159,7 @@ public:
       }
 
       // HELPER METHODS
-      size_t size() {return rh_patterns.size();}
+      size_t size() const {return rh_patterns.size();}
       RightHandPattern& operator[](size_t idx){return rh_patterns[idx]; }
       const RightHandPattern& operator[](size_t idx) const {return rh_patterns[idx]; }
 
@@ -184,7 +185,7 @@ public:
   BassChoice get_bass(int deg, std::uint64_t& rng_state);
   BassChoice get_bass(int deg, bool allow_inversions, std::uint64_t& rng_state);
 
-  RightHandPatterns get_ps();
+  const RightHandPatterns& get_ps() const;
 
   static const std::string& default_profile_id();
   const std::string& resolve_profile_id(std::string_view profile_id) const;
@@ -194,20 +195,23 @@ public:
   const std::vector<RightHandPattern>& right_hand_options(TriadQuality quality,
                                                           std::string_view profile_id = default_profile_id()) const;
 
-  const BassPattern& bass(TriadQuality quality, const std::string& id,
+  const BassPattern& bass(TriadQuality quality, std::string_view id,
                           std::string_view profile_id = default_profile_id()) const;
-  const RightHandPattern& right_hand(TriadQuality quality, const std::string& id,
+  const RightHandPattern& right_hand(TriadQuality quality, std::string_view id,
                                      std::string_view profile_id = default_profile_id()) const;
 
   Selection pick_triad(TriadQuality quality,
                        std::uint64_t& rng_state,
-                       std::optional<std::string> preferred_right = std::nullopt,
-                       std::optional<std::string> preferred_bass = std::nullopt,
-                        std::optional<std::string> avoid_right = std::nullopt,
+                       std::optional<std::string_view> preferred_right = std::nullopt,
+                       std::optional<std::string_view> preferred_bass = std::nullopt,
+                        std::optional<std::string_view> avoid_right = std::nullopt,
                        std::string_view profile_id = default_profile_id()) const;
 
 private:
-  ChordVoicingEngine();
+  // Only cheap runtime state lives in the singleton; the voicing tables are
+  // function-local statics, so instance() is constant-initialized and free of
+  // the one-shot construction cost.
+  ChordVoicingEngine() = default;
 
   KeyQuality keytype_{};
   DrillInstrument inst_{};
@@ -226,17 +230,20 @@ private:
 
   struct Profile {
     std::string id;
-    QualitySet triads[3];
+    // All triad qualities currently share one canonical pattern set per
+    // profile; specialize per quality here if profiles ever diverge.
+    QualitySet triads;
   };
 
-  static std::size_t quality_index(TriadQuality quality);
+  [[nodiscard]] static constexpr std::size_t quality_index(TriadQuality quality) noexcept {
+    return static_cast<std::size_t>(quality);
+  }
+  static const std::array<Profile, 3>& builtin_profiles();
   const Profile& profile_for(std::string_view profile_id) const;
-
-  std::unordered_map<std::string, Profile> profiles_;
 };
 
 TriadQuality triad_quality_from_string(const std::string& quality);
 
-std::string to_string(TriadQuality quality);
+std::string_view to_string(TriadQuality quality);
 
 } // namespace ear
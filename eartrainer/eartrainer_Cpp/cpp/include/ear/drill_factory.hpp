@@ -2,7 +2,7 @@
 #include <functional>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 #include "drill_spec.hpp"
@@ -24,16 +24,24 @@ public:
 
   static DrillFactory& instance();
 
-  void register_family(const std::string& family, Creator create);
+  void register_family(std::string_view family, Creator create);
 
-  std::unique_ptr<DrillModule> create_module(const std::string& family) const;
+  std::unique_ptr<DrillModule> create_module(std::string_view family) const;
 
   DrillAssignment create(const DrillSpec& spec) const;
+  DrillAssignment create(DrillSpec&& spec) const;
 
   std::vector<DrillAssignment> create_for_level(const std::vector<DrillSpec>& all, int level) const;
 
 private:
-  std::unordered_map<std::string, Creator> registry_;
+  DrillAssignment assemble(DrillSpec spec, std::unique_ptr<DrillModule> module) const;
+  const Creator* find_registered(std::string_view family) const;
+
+  // Builtins never land here (create_module dispatches them statically), so
+  // this only ever holds a handful of custom families - a flat vector with a
+  // linear scan beats an unordered_map's buckets at that size, mirroring
+  // AssistancePolicy.
+  std::vector<std::pair<std::string, Creator>> registry_;
 };
 
 void register_builtin_drills(DrillFactory& factory);
@@ -1,13 +1,8 @@
 #pragma once
 #include <optional>
-#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <vector>
 
 #include "../resources/drill_params.hpp"
-#include "../nlohmann/json.hpp"
-#include "types.hpp"
 
 // SessionSpec is defined in ear/types.hpp; needed for conversion helpers.
 #include "types.hpp"
@@ -17,6 +12,9 @@
  * Flexible enough for melody, chords, intervals, mixed.
  */
 struct DrillSpec {
+  // id/family/key stay std::string on purpose: every value comes from a
+  // closed set of short literals (see catalog_numbered::family_of) and fits
+  // SSO, so an interning pool would remove no allocations here.
   std::string id;
   std::string family;
   std::optional<int> level;
@@ -25,18 +23,8 @@ struct DrillSpec {
   // Resolved configuration (available to drills without extra parsing).
   std::string key = "C";
   ear::KeyQuality quality = ear::KeyQuality::Major;
-  std::unordered_map<std::string, int> assistance_policy;
+  ear::AssistancePolicy assistance_policy;
   ear::DrillParams params{};
 
-  // Raw authoring data (kept for serialization/backward compatibility).
-  nlohmann::json defaults;        // core defaults (tempo, key, range, assistance...)
-
-  // Convenience helpers on raw defaults
-  // bool has_default(const char* k) const { return defaults.contains(k); }
-  // template <class T> T def_as(const char* k, const T& fallback) const {
-  //   if (!defaults.contains(k)) return fallback;
-  //   return defaults[k].get<T>();
-  // }
-
   static DrillSpec from_session(const ear::SessionSpec& spec);
 };
@@ -9,21 +9,25 @@
 #include <vector>
 #include <filesystem>
 #include <unordered_map>
-#include <map>
 
 namespace ear {
 
 class LevelInspector {
 public:
+  // (tier, specs) pairs sorted by tier. A level holds a handful of tiers, so
+  // a flat sorted vector walks contiguously where a tree map chased nodes
+  // (same reasoning as DrillFactory's registry_).
+  using TierSpecs = std::vector<std::pair<int, std::vector<DrillSpec>>>;
+
   LevelInspector(std::filesystem::path resources_dir,
                  std::string catalog_basename,
                  std::uint64_t seed = 1);
 
   void set_base_spec(const SessionSpec& spec);
 
-  std::string overview() const;
-  std::string levels_summary() const;
-  std::vector<int> known_levels() const;
+  const std::string& overview() const;
+  const std::string& levels_summary() const;
+  const std::vector<int>& known_levels() const;
   std::vector<int> tiers_for_level(int level) const;
   std::vector<LevelCatalogEntry> catalog_entries() const;
 
@@ -42,24 +46,38 @@ private:
   };
 
   void load_catalog();
+  std::string build_overview() const;
+  std::string build_levels_summary() const;
   std::string make_question_id();
   const resources::ManifestView::Lesson* lesson_for(int level) const;
-  std::map<int, std::vector<DrillSpec>> describe_level_specs(int level) const;
+  const TierSpecs& describe_level_specs(int level) const;
 
   std::string catalog_basename_;
   std::string catalog_display_name_;
+  // Deterministic functions of the immutable catalog, rendered once per
+  // load_catalog() so polling callers do not re-format the whole tree.
+  std::string overview_cache_;
+  std::string summary_cache_;
   std::vector<int> levels_;
   std::vector<std::string> allowed_catalogs_;
   std::vector<Slot> slots_;
   std::uint64_t master_rng_;
   std::uint64_t question_counter_ = 0;
   std::size_t next_slot_index_ = 0;
-  std::optional<int> active_level_;
-  std::optional<int> active_tier_;
+  // -1 means no selection; levels are non-negative, and tier -1 (the
+  // untiered bucket) is only meaningful once a level is active.
+  int active_level_ = -1;
+  int active_tier_ = -1;
   DrillFactory& factory_;
   std::optional<std::string> base_key_;
   resources::ManifestView manifest_;
-  std::unordered_map<int, const resources::ManifestView::Lesson*> lesson_lookup_;
+  // Sorted by level; a few dozen entries at most, so lower_bound over a
+  // contiguous vector beats hashing into node storage.
+  std::vector<std::pair<int, const resources::ManifestView::Lesson*>> lesson_lookup_;
+  // The catalog is immutable after load_catalog(), so the per-level tier map
+  // is built once there; every describe_level_specs call used to rebuild it
+  // (re-running each drill's build() and re-formatting ids).
+  std::unordered_map<int, TierSpecs> tier_cache_;
 };
 
 } // namespace ear
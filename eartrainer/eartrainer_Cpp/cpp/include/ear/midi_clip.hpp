@@ -1,16 +1,51 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../nlohmann/json.hpp"
 
 namespace ear {
 
+// Event kinds carry their wire name only at the JSON boundary; in memory a
+// byte-sized enum keeps MidiEvent compact for the sort and export walks.
+enum class MidiEventType : std::uint8_t { NoteOn, NoteOff, Control, Meta };
+
+constexpr const char* midi_event_type_name(MidiEventType type) {
+  switch (type) {
+    case MidiEventType::NoteOn:  return "note_on";
+    case MidiEventType::NoteOff: return "note_off";
+    case MidiEventType::Control: return "control";
+    case MidiEventType::Meta:    return "meta";
+  }
+  return "note_on";
+}
+
+inline MidiEventType midi_event_type_from_string(std::string_view name) {
+  switch (name.size()) {
+    case 4:
+      if (name == "meta") return MidiEventType::Meta;
+      break;
+    case 7:
+      if (name == "note_on") return MidiEventType::NoteOn;
+      if (name == "control") return MidiEventType::Control;
+      break;
+    case 8:
+      if (name == "note_off") return MidiEventType::NoteOff;
+      break;
+    default:
+      break;
+  }
+  throw std::runtime_error("Unknown MidiEvent type: " + std::string(name));
+}
+
 struct MidiEvent {
   int t = 0;
-  std::string type;
+  MidiEventType type = MidiEventType::NoteOn;
   std::optional<int> note;
   std::optional<int> vel;
   std::optional<int> control;
@@ -48,9 +83,14 @@ public:
 
   int ms_to_ticks(int dur_ms) const;
   int beats_to_ticks(Beats beats) const;
+  double ticks_per_ms() const { return ticks_per_ms_; }
+
+  void reserve_tracks(std::size_t track_count);
+  void reserve_notes(int track_index, std::size_t note_count);
 
   int add_track(const std::string& name, int channel, int program);
   void add_event(int track_index, const MidiEvent& event);
+  void add_event(int track_index, MidiEvent&& event);
   void add_note_ticks(int track_index, int start_ticks, int dur_ticks, int note,
                 std::optional<int> velocity = std::optional<int>(90));
   void add_note(int track_index, Beats start, Beats dur, int note, 
@@ -67,6 +107,7 @@ private:
   void update_length(int candidate);
 
   MidiClip clip_;
+  double ticks_per_ms_ = 0.0;
 };
 
 nlohmann::json to_json(const MidiClip& clip);
@@ -47,7 +47,7 @@ inline std::string to_string(SessionMode mode) {
   return "manual";
 }
 
-inline SessionMode session_mode_from_string(const std::string& value) {
+inline std::optional<SessionMode> try_session_mode_from_string(const std::string& value) {
   if (value == "manual") {
     return SessionMode::Manual;
   }
@@ -57,9 +57,20 @@ inline SessionMode session_mode_from_string(const std::string& value) {
   if (value == "level_inspector") {
     return SessionMode::LevelInspector;
   }
+  return std::nullopt;
+}
+
+inline SessionMode session_mode_from_string(const std::string& value) {
+  if (const auto mode = try_session_mode_from_string(value)) {
+    return *mode;
+  }
   throw std::invalid_argument("Unknown session mode: " + value);
 }
 
+// Assistance policies are a small closed set (~8 kinds); a flat vector of
+// (kind, budget) pairs beats an unordered_map's per-key buckets at this size.
+using AssistancePolicy = std::vector<std::pair<std::string, int>>;
+
 struct SessionSpec {
   std::string version;
   std::string drill_kind;
@@ -67,7 +78,7 @@ struct SessionSpec {
   std::optional<int> tempo_bpm;
   int n_questions;
   std::string generation;
-  std::unordered_map<std::string, int> assistance_policy;
+  AssistancePolicy assistance_policy;
   ear::DrillParams params;
   nlohmann::json sampler_params;
   std::uint64_t seed;
@@ -129,7 +140,9 @@ struct ResultReport {
     int rt_ms;
     int attempts;
     int question_count;
-    std::unordered_map<std::string, int> assists_used;
+    // Flat like AssistancePolicy: a report carries a handful of assist
+    // kinds, so a vector scan beats hashing and keeps round-trip order.
+    std::vector<std::pair<std::string, int>> assists_used;
     std::optional<int> first_input_rt_ms;
   } metrics;
 
@@ -2,12 +2,14 @@
 
 #include <cassert>
 #include <cctype>
+#include <charconv>
 #include <cmath>
 #include <cstdint>
 #include <map>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -19,7 +21,9 @@ namespace nlohmann {
 
 class json {
 public:
-  using object_t = std::map<std::string, json>;
+  // Transparent comparator so string_view / literal keys probe the map
+  // without materializing a std::string per lookup.
+  using object_t = std::map<std::string, json, std::less<>>;
   using array_t = std::vector<json>;
   using string_t = std::string;
   using boolean_t = bool;
@@ -54,6 +58,28 @@ public:
   static json object() { return json(object_t{}); }
   static json array() { return json(array_t{}); }
 
+  // The stored alternative, in declaration order of variant_t. Hot converters
+  // can switch on this once instead of chaining is_* probes.
+  enum class value_t : std::size_t {
+    null = 0, boolean, number_integer, number_float, string, array, object
+  };
+  value_t type() const noexcept { return static_cast<value_t>(data_.index()); }
+
+  number_integer_t get_integer_unchecked() const noexcept {
+    assert(is_number_integer());
+    return *std::get_if<number_integer_t>(&data_);
+  }
+
+  number_float_t get_float_unchecked() const noexcept {
+    assert(is_number_float());
+    return *std::get_if<number_float_t>(&data_);
+  }
+
+  boolean_t get_boolean_unchecked() const noexcept {
+    assert(is_boolean());
+    return *std::get_if<boolean_t>(&data_);
+  }
+
   bool is_null() const { return std::holds_alternative<std::nullptr_t>(data_); }
   bool is_boolean() const { return std::holds_alternative<boolean_t>(data_); }
   bool is_number() const { return is_number_integer() || is_number_float(); }
@@ -130,7 +156,7 @@ public:
     return std::get<object_t>(data_)[key];
   }
 
-  const json& operator[](const std::string& key) const {
+  const json& operator[](std::string_view key) const {
     ensure_type_object();
     auto it = std::get<object_t>(data_).find(key);
     if (it == std::get<object_t>(data_).end()) {
@@ -168,6 +194,27 @@ public:
     std::get<array_t>(data_).push_back(value);
   }
 
+  // Rvalue overload so moved-in subtrees transfer their storage instead of
+  // deep-copying node by node.
+  void push_back(json&& value) {
+    if (!is_array()) {
+      if (!is_null()) {
+        throw std::runtime_error("json value is not an array");
+      }
+      data_ = array_t{};
+    }
+    std::get<array_t>(data_).push_back(std::move(value));
+  }
+
+  // Pre-sizes the backing vector of an array value; no-op for other types.
+  // json nodes are fat variants, so growth reallocations are expensive for
+  // callers that know their element count up front.
+  void reserve(std::size_t capacity) {
+    if (auto* arr = std::get_if<array_t>(&data_)) {
+      arr->reserve(capacity);
+    }
+  }
+
   std::size_t size() const {
     if (is_array()) {
       return std::get<array_t>(data_).size();
@@ -180,12 +227,24 @@ public:
 
   bool empty() const { return size() == 0; }
 
-  bool contains(const std::string& key) const {
+  bool contains(std::string_view key) const {
     if (!is_object()) { return false; }
     return std::get<object_t>(data_).count(key) > 0;
   }
 
-  json value(const std::string& key, const json& default_value) const {
+  // Single-lookup accessor: returns the member or nullptr when the key is
+  // absent (or when this value is not an object). Replaces the
+  // contains()+operator[] double lookup.
+  const json* find_member(std::string_view key) const noexcept {
+    const auto* obj = std::get_if<object_t>(&data_);
+    if (!obj) {
+      return nullptr;
+    }
+    auto it = obj->find(key);
+    return it == obj->end() ? nullptr : &it->second;
+  }
+
+  json value(std::string_view key, const json& default_value) const {
     if (!is_object()) {
       return default_value;
     }
@@ -281,15 +340,14 @@ private:
       if (pos >= text.size() || text[pos] != '"') {
         throw std::runtime_error("json parse error: expected string key");
       }
-      json key_json = parse_string(text, pos);
-      std::string key = key_json.get_string();
+      std::string key = parse_string_raw(text, pos);
       skip_whitespace(text, pos);
       if (pos >= text.size() || text[pos] != ':') {
         throw std::runtime_error("json parse error: expected ':' after key");
       }
       ++pos; // skip ':'
       skip_whitespace(text, pos);
-      obj[key] = parse_value(text, pos);
+      obj.insert_or_assign(std::move(key), parse_value(text, pos));
       skip_whitespace(text, pos);
       if (pos >= text.size()) {
         throw std::runtime_error("json parse error: unexpected end in object");
@@ -334,6 +392,12 @@ private:
   }
 
   static json parse_string(const std::string& text, std::size_t& pos) {
+    return json(parse_string_raw(text, pos));
+  }
+
+  // Parses directly into a std::string so object keys never take a detour
+  // through a temporary json node.
+  static std::string parse_string_raw(const std::string& text, std::size_t& pos) {
     std::string result;
     ++pos; // skip opening quote
     while (pos < text.size()) {
@@ -440,41 +504,48 @@ private:
       read_digits(true);
     }
 
-    std::string number_str = text.substr(start, pos - start);
-    try {
-      if (is_float) {
-        return json(std::stod(number_str));
+    // The grammar was validated above, so conversion goes through
+    // std::from_chars on the original buffer: no substr allocation, no
+    // locale, and no exception setup for the integer fast path. Integers
+    // that overflow int64 fall back to the float representation.
+    const char* first = text.data() + start;
+    const char* last = text.data() + pos;
+    if (!is_float) {
+      number_integer_t int_value = 0;
+      const auto result = std::from_chars(first, last, int_value);
+      if (result.ec == std::errc() && result.ptr == last) {
+        return json(int_value);
       }
-      return json(static_cast<number_integer_t>(std::stoll(number_str)));
+    }
+    const std::string number_str(first, last);
+    try {
+      return json(std::stod(number_str));
     } catch (...) {
       throw std::runtime_error("json parse error: invalid number");
     }
   }
 
   static json parse_true(const std::string& text, std::size_t& pos) {
-    const std::string token = "true";
-    if (text.substr(pos, token.size()) != token) {
+    if (text.compare(pos, 4, "true") != 0) {
       throw std::runtime_error("json parse error: invalid literal");
     }
-    pos += token.size();
+    pos += 4;
     return json(true);
   }
 
   static json parse_false(const std::string& text, std::size_t& pos) {
-    const std::string token = "false";
-    if (text.substr(pos, token.size()) != token) {
+    if (text.compare(pos, 5, "false") != 0) {
       throw std::runtime_error("json parse error: invalid literal");
     }
-    pos += token.size();
+    pos += 5;
     return json(false);
   }
 
   static json parse_null(const std::string& text, std::size_t& pos) {
-    const std::string token = "null";
-    if (text.substr(pos, token.size()) != token) {
+    if (text.compare(pos, 4, "null") != 0) {
       throw std::runtime_error("json parse error: invalid literal");
     }
-    pos += token.size();
+    pos += 4;
     return json(nullptr);
   }
 
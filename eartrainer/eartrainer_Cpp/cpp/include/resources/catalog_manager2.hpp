@@ -35,23 +35,19 @@ struct ManifestView {
   const HarmonyList& harmony;
   const ChordList& chords;
 
-  const Lesson* melody_entry(int level) const {
-    const auto it = std::find_if(melody.begin(), melody.end(),
+  // The three track accessors share one lookup body; keeping a single copy
+  // means one find_if instantiation for all tracks instead of three clones.
+  static const Lesson* find_entry(const std::vector<Lesson>& list, int level) {
+    const auto it = std::find_if(list.begin(), list.end(),
                                  [level](const Lesson& node) { return node.lesson == level; });
-    return it == melody.end() ? nullptr : &(*it);
+    return it == list.end() ? nullptr : &(*it);
   }
 
-  const Lesson* harmony_entry(int level) const {
-    const auto it = std::find_if(harmony.begin(), harmony.end(),
-                                 [level](const Lesson& node) { return node.lesson == level; });
-    return it == harmony.end() ? nullptr : &(*it);
-  }
+  const Lesson* melody_entry(int level) const { return find_entry(melody, level); }
 
-  const Lesson* chord_entry(int level) const {
-    const auto it = std::find_if(chords.begin(), chords.end(),
-                                 [level](const Lesson& node) { return node.lesson == level; });
-    return it == chords.end() ? nullptr : &(*it);
-  }
+  const Lesson* harmony_entry(int level) const { return find_entry(harmony, level); }
+
+  const Lesson* chord_entry(int level) const { return find_entry(chords, level); }
 
   const Lesson* entry(int level, const char* family) const {
     const std::string_view name{family};
@@ -77,6 +77,9 @@ inline const char* lesson_to_family(int lesson_number) {
     return "none";
 }
 
+// Specs are built straight from typed DrillParams builders; no intermediate
+// json/YAML tree ever exists here, so there is no transient allocation worth
+// arena-backing - the only per-spec heap traffic is the spec's own storage.
 inline DrillSpec make_spec_from_entry(const DrillEntry& e) {
     DrillParams params = e.build();
     DrillSpec s;
@@ -144,8 +147,7 @@ struct NumberedCatalog {
         std::vector<DrillSpec> specs;
         specs.reserve(f->second.size());
         for (const auto& e : f->second) specs.push_back(make_spec_from_entry(e));
-        auto& stored = cache[level_block] = std::move(specs);
-        return stored;
+        return cache.emplace(level_block, std::move(specs)).first->second;
     }
 };
 
@@ -73,9 +73,10 @@ FieldSpec<T> make_int(std::string key, std::string label,
     },
     // parse
     [key,mem,mn,mx](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return; // keep default
-      if (!obj[key].is_number_integer()) { errs.push_back(key + ": not int"); return; }
-      int v = obj[key].get<int>();
+      const auto* field = obj.find_member(key);
+      if (!field) return; // keep default
+      if (!field->is_number_integer()) { errs.push_back(key + ": not int"); return; }
+      int v = field->get<int>();
       if (v < mn || v > mx) { errs.push_back(key + ": out of range"); return; }
       dst.*mem = v;
     }
@@ -92,9 +93,10 @@ FieldSpec<T> make_double(std::string key, std::string label,
                         {"default", d.*mem}, {"min",mn},{"max",mx},{"step",step}});
     },
     [key,mem,mn,mx](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return;
-      if (!obj[key].is_number()) { errs.push_back(key + ": not number"); return; }
-      double v = obj[key].get<double>();
+      const auto* field = obj.find_member(key);
+      if (!field) return;
+      if (!field->is_number()) { errs.push_back(key + ": not number"); return; }
+      double v = field->get<double>();
       if (v < mn || v > mx) { errs.push_back(key + ": out of range"); return; }
       dst.*mem = v;
     }
@@ -109,9 +111,10 @@ FieldSpec<T> make_bool(std::string key, std::string label, bool T::* mem) {
       fields.push_back({{"key",key},{"label",label},{"kind","bool"},{"default", d.*mem}});
     },
     [key,mem](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return;
-      if (!obj[key].is_boolean()) { errs.push_back(key + ": not bool"); return; }
-      dst.*mem = obj[key].get<bool>();
+      const auto* field = obj.find_member(key);
+      if (!field) return;
+      if (!field->is_boolean()) { errs.push_back(key + ": not bool"); return; }
+      dst.*mem = field->get<bool>();
     }
   };
 }
@@ -126,10 +129,11 @@ FieldSpec<T> make_optional_bool(std::string key, std::string label, std::optiona
       fields.push_back(std::move(f));
     },
     [key,mem](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return; // leave as std::nullopt
-      if (obj[key].is_null()) { dst.*mem = std::nullopt; return; }
-      if (!obj[key].is_boolean()) { errs.push_back(key + ": not bool/null"); return; }
-      dst.*mem = obj[key].get<bool>();
+      const auto* field = obj.find_member(key);
+      if (!field) return; // leave as std::nullopt
+      if (field->is_null()) { dst.*mem = std::nullopt; return; }
+      if (!field->is_boolean()) { errs.push_back(key + ": not bool/null"); return; }
+      dst.*mem = field->get<bool>();
     }
   };
 }
@@ -142,10 +146,11 @@ FieldSpec<T> make_vec_int(std::string key, std::string label, std::vector<int> T
       fields.push_back({{"key",key},{"label",label},{"kind","int_list"},{"default", d.*mem}});
     },
     [key,mem](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return;
-      if (!obj[key].is_array()) { errs.push_back(key + ": not array"); return; }
+      const auto* field = obj.find_member(key);
+      if (!field) return;
+      if (!field->is_array()) { errs.push_back(key + ": not array"); return; }
       std::vector<int> out;
-      for (auto& el : obj[key]) {
+      for (auto& el : *field) {
         if (!el.is_number_integer()) { errs.push_back(key + ": array has non-int"); return; }
         out.push_back(el.get<int>());
       }
@@ -167,9 +172,10 @@ FieldSpec<T> make_enum(std::string key, std::string label, Enum T::* mem,
                         {"default", static_cast<int>(d.*mem)}, {"choices", ch}});
     },
     [key,mem,choices](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return;
-      if (!obj[key].is_number_integer()) { errs.push_back(key + ": not int"); return; }
-      int v = obj[key].get<int>();
+      const auto* field = obj.find_member(key);
+      if (!field) return;
+      if (!field->is_number_integer()) { errs.push_back(key + ": not int"); return; }
+      int v = field->get<int>();
       bool ok=false; for (auto& c:choices) if (c.value==v) { ok=true; break; }
       if (!ok) { errs.push_back(key + ": invalid enum value"); return; }
       dst.*mem = static_cast<std::remove_reference_t<decltype(dst.*mem)>>(v);
@@ -190,9 +196,10 @@ FieldSpec<T> make_nested(std::string key, std::string label, Nested T::* mem,
       fields.push_back(std::move(j));      // client can recurse
     },
     [key,mem,&nested_schema](const nlohmann::json& obj, T& dst, std::vector<std::string>& errs){
-      if (!obj.contains(key)) return;
-      if (!obj[key].is_object()) { errs.push_back(key + ": not object"); return; }
-      auto [val, e] = nested_schema.from_json(obj[key]);
+      const auto* field = obj.find_member(key);
+      if (!field) return;
+      if (!field->is_object()) { errs.push_back(key + ": not object"); return; }
+      auto [val, e] = nested_schema.from_json(*field);
       if (!e.empty()) { for (auto& s: e) errs.push_back(key + "." + s); return; }
       dst.*mem = *val;
     }
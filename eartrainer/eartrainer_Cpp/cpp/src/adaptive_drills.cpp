@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
-#include <mutex>
 #include <sstream>
 #include <string_view>
 #include <utility>
@@ -41,11 +40,9 @@ void adaptive_debug(const std::string& message) {
 }
 
 void ensure_factory_registered() {
-  static std::once_flag flag;
-  std::call_once(flag, []() {
-    auto& factory = DrillFactory::instance();
-    register_builtin_drills(factory);
-  });
+  // Builtins dispatch statically inside the factory; registration is an
+  // idempotent no-op hook, so no call_once gate is needed.
+  register_builtin_drills(DrillFactory::instance());
 }
 
 int track_index_for_family(std::string_view name) {
@@ -78,17 +75,17 @@ AdaptiveDrills::AdaptiveDrills(std::string resources_dir, std::uint64_t seed)
 }
 
 AdaptiveDrills::TrackPick AdaptiveDrills::pick_track(const std::vector<int>& current_levels) {
-  const auto pick_info = manifest_.pick_track(current_levels, master_rng_);
+  auto pick_info = manifest_.pick_track(current_levels, master_rng_);
 
   TrackPick pick;
   pick.node = pick_info.node;
   pick.track_index = pick_info.track_index;
-  pick.weights = pick_info.weights;
-  pick.normalized_levels = pick_info.normalized_levels;
 
-  last_track_pick_ = pick_info.node ? std::optional{pick_info} : std::nullopt;
-  last_track_levels_ = pick.normalized_levels;
-  last_track_weights_ = pick.weights;
+  // Steal the selection's vectors rather than copying them; the diagnostics
+  // members are their only consumers.
+  last_track_levels_ = std::move(pick_info.normalized_levels);
+  last_track_weights_ = std::move(pick_info.weights);
+  last_track_pick_ = pick.node ? std::optional{pick} : std::nullopt;
 
   return pick;
 }
@@ -226,7 +223,7 @@ void AdaptiveDrills::initialize_bout(
     Slot slot;
     slot.id = std::move(assignment.id);
     slot.family = std::move(assignment.family);
-    slot.spec = assignment.spec;
+    slot.spec = std::move(assignment.spec);
     slot.module = std::move(assignment.module);
     slot.rng_state = advance_rng(seed);
     slots_.push_back(std::move(slot));
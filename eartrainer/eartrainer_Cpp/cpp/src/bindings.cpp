@@ -84,7 +84,7 @@ public:
 
   std::string create_session(py::object spec_obj) {
     auto spec_json = py_to_json(spec_obj);
-    auto spec = ear::bridge::session_spec_from_json(spec_json);
+    auto spec = ear::bridge::session_spec_from_json(std::move(spec_json));
     return engine_->create_session(spec);
   }
 
@@ -124,7 +124,7 @@ public:
 
   py::object level_catalog_entries(py::object spec_obj) {
     auto spec_json = py_to_json(spec_obj);
-    auto spec = ear::bridge::session_spec_from_json(spec_json);
+    auto spec = ear::bridge::session_spec_from_json(std::move(spec_json));
     auto entries = engine_->level_catalog_entries(spec);
     nlohmann::json json_entries = nlohmann::json::array();
     for (const auto& entry : entries) {
@@ -135,7 +135,7 @@ public:
 
   py::object submit_result(const std::string& session_id, py::object report_obj) {
     auto report_json = py_to_json(report_obj);
-    auto report = ear::bridge::result_report_from_json(report_json);
+    auto report = ear::bridge::result_report_from_json(std::move(report_json));
     auto next = engine_->submit_result(session_id, report);
     if (auto bundle = std::get_if<ear::QuestionBundle>(&next)) {
       return json_to_py(ear::bridge::to_json(*bundle));
@@ -7,7 +7,11 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <utility>
 
 using TriadQuality = ear::TriadQuality;
 namespace ear {
@@ -19,12 +23,6 @@ using RHChords = ChordVoicingEngine::RightHandPatterns;
 using RightVoicing = ChordVoicingEngine::RightVoicing;
 using BassChoice = ChordVoicingEngine::BassChoice;
 
-constexpr std::array<TriadQuality, 3> kAllQualities = {
-    TriadQuality::Major,
-    TriadQuality::Minor,
-    TriadQuality::Diminished,
-};
-
 std::vector<BassPattern> make_default_triad_bass_patterns() {
   return {
       {"root_low", -14},
@@ -72,16 +70,20 @@ std::vector<RHChord> make_simple_triad_right_patterns() {
   };
 }
 
-RHChords get_rh_chords(const VoicingsStyle& inst){
+const RHChords& get_rh_chords(const VoicingsStyle& inst){
+  // Built once per style; callers borrow instead of copying every voicing.
+  static const RHChords piano{make_default_triad_right_patterns()};
+  static const RHChords strings{make_strings_triad_right_patterns()};
+  static const RHChords triad{make_simple_triad_right_patterns()};
   switch (inst){
     case VoicingsStyle::Piano:
-      return RHChords{std::move(make_default_triad_right_patterns())};
+      return piano;
     case VoicingsStyle::Strings:
-      return RHChords{std::move(make_strings_triad_right_patterns())};
+      return strings;
     case VoicingsStyle::Triad:
-      return RHChords{std::move(make_simple_triad_right_patterns())};
+      return triad;
     default:
-      return RHChords{std::move(make_default_triad_right_patterns())};
+      return piano;
     //case DrillInstrument::Guitar;
   }
 }
@@ -100,11 +102,11 @@ std::vector<BassPattern> get_bass_options(const VoicingsStyle& inst){
   }
 }
 
-std::size_t index_for(TriadQuality quality) {
+[[nodiscard]] constexpr std::size_t index_for(TriadQuality quality) noexcept {
   return static_cast<std::size_t>(quality);
 }
 
-const char* quality_name(TriadQuality quality) {
+[[nodiscard]] constexpr std::string_view quality_name(TriadQuality quality) noexcept {
   switch (quality) {
   case TriadQuality::Major:
     return "major";
@@ -123,42 +125,36 @@ const std::string& ChordVoicingEngine::default_profile_id() {
   return kDefault;
 }
 
-ChordVoicingEngine::ChordVoicingEngine() {
-  Profile piano;
-  piano.id = default_profile_id();
-  const auto default_bass = make_default_triad_bass_patterns();
-  const auto default_right = make_default_triad_right_patterns();
-  for (TriadQuality quality : kAllQualities) {
-    auto& set = piano.triads[index_for(quality)];
-    set.bass = default_bass;
-    set.right = default_right;
-  }
-  profiles_.emplace(piano.id, std::move(piano));
-
-  Profile strings;
-  strings.id = "strings_ensemble";
-  const auto strings_bass = make_strings_triad_bass_patterns();
-  const auto strings_right = make_strings_triad_right_patterns();
-  for (TriadQuality quality : kAllQualities) {
-    auto& set = strings.triads[index_for(quality)];
-    set.bass = strings_bass;
-    set.right = strings_right;
-  }
-  profiles_.emplace(strings.id, std::move(strings));
-
-  Profile simple;
-  simple.id = "simple_triads";
-  const auto simple_bass = make_simple_triad_bass_patterns();
-  const auto simple_right = make_simple_triad_right_patterns();
-  for (TriadQuality quality : kAllQualities) {
-    auto& set = simple.triads[index_for(quality)];
-    set.bass = simple_bass;
-    set.right = simple_right;
-  }
-  profiles_.emplace(simple.id, std::move(simple));
+const std::array<ChordVoicingEngine::Profile, 3>& ChordVoicingEngine::builtin_profiles() {
+  static const std::array<Profile, 3> kProfiles = [] {
+    struct Seed {
+      std::string id;
+      std::vector<BassPattern> (*bass)();
+      std::vector<RHChord> (*right)();
+    };
+    const Seed seeds[3] = {
+        {default_profile_id(), &make_default_triad_bass_patterns,
+         &make_default_triad_right_patterns},
+        {"strings_ensemble", &make_strings_triad_bass_patterns,
+         &make_strings_triad_right_patterns},
+        {"simple_triads", &make_simple_triad_bass_patterns,
+         &make_simple_triad_right_patterns},
+    };
+
+    std::array<Profile, 3> profiles;
+    for (std::size_t i = 0; i < profiles.size(); ++i) {
+      profiles[i].id = seeds[i].id;
+      profiles[i].triads.bass = seeds[i].bass();
+      profiles[i].triads.right = seeds[i].right();
+    }
+    return profiles;
+  }();
+  return kProfiles;
 }
 
 ChordVoicingEngine& ChordVoicingEngine::instance() {
+  // Holds only trivially-constructible session state, so this is
+  // constant-initialized and carries no static-guard cost per call.
   static ChordVoicingEngine engine;
   return engine;
 }
@@ -178,29 +174,40 @@ void ChordVoicingEngine::configure(
 }
 
 RightVoicing ChordVoicingEngine::get_voicing(int deg, std::uint64_t& rng_state){
-  // GET VOICINGS -> SHIFT TO CHORD DEGREE -> SHIFT TO MIDIS
-  RHChords rh_chords = get_rh_chords(voicing_style_);
-  RHChords shifted_chords = rh_chords.shift_to(deg);
+  // PICK ONE VOICING FIRST -> SHIFT ONLY THE CHOSEN CHORD -> SHIFT TO MIDIS
+  const RHChords& rh_chords = get_rh_chords(voicing_style_);
+  size_t size = rh_chords.size();
+
+  // VOICE LEADING CONTINUITY: keep voicings whose shifted top degree stays
+  // adjacent to the previous chord's top; fall back to all when none qualify.
+  std::vector<size_t> candidates;
+  candidates.reserve(size);
   if (continuity_ && top_degree_.has_value()){
-    RHChords new_chords = shifted_chords.filter_by_top_degree(top_degree_.value());
-    shifted_chords = new_chords;
+    for (size_t i = 0; i < size; ++i){
+      if (std::abs(rh_chords[i].degree_offsets.back() + deg - top_degree_.value()) <= 1){
+        candidates.push_back(i);
+      }
+    }
+  }
+  if (candidates.empty()){
+    for (size_t i = 0; i < size; ++i){candidates.push_back(i);}
   }
-  RHChords midi_chords = shifted_chords.to_midi(keytype_, tonic_midi_);
 
   // SAMPLE
-  size_t size = midi_chords.size();
-  int idx = rand_int(rng_state, 0, static_cast<int>(size) - 1);
-  RHChord shifted_chord = shifted_chords[idx];
-  RHChord midi_chord = midi_chords[idx];
-  
+  int pick = rand_int(rng_state, 0, static_cast<int>(candidates.size()) - 1);
+  size_t idx = candidates[static_cast<size_t>(pick)];
+  RHChord shifted_chord = rh_chords[idx].shift_to(deg);
+  RHChord midi_chord = shifted_chord.to_midi(keytype_, tonic_midi_);
+
   top_degree_ = shifted_chord.degree_offsets.back();
   int top_midi_ = midi_chord.degree_offsets.back();
 
+  // Hand the scratch arrays to the caller instead of copying them.
   return RightVoicing{
-    midi_chord.id,
+    std::move(midi_chord.id),
     degree_to_quality(deg),
-    shifted_chord.degree_offsets,
-    midi_chord.degree_offsets,
+    std::move(shifted_chord.degree_offsets),
+    std::move(midi_chord.degree_offsets),
     top_midi_
   };
 }
@@ -226,8 +233,12 @@ BassChoice ChordVoicingEngine::get_bass(int deg, bool allow_inversions, std::uin
   const BassPattern& bass = options[pick];
 
   int bass_deg = bass.degree_offset + deg;
-  int idx = bass_deg%7; if (idx < 0) idx+=7;
-  int octave = (bass_deg-idx)/7;
+  // Bias into unsigned range so %7 and /7 compile to multiply-high instead of
+  // two signed IDIVs (|bass_deg| stays well under the bias).
+  constexpr int kBias = 70;
+  unsigned u = static_cast<unsigned>(bass_deg + kBias);
+  int idx = static_cast<int>(u - (u / 7u) * 7u);
+  int octave = static_cast<int>(u / 7u) - kBias / 7;
   int bass_midi = scale_steps_ptr[static_cast<size_t>(idx)] + 12*octave + tonic_midi_;
   
   return BassChoice {
@@ -238,48 +249,46 @@ BassChoice ChordVoicingEngine::get_bass(int deg, bool allow_inversions, std::uin
   };
 }
 
-RHChords ChordVoicingEngine::get_ps(){
+const RHChords& ChordVoicingEngine::get_ps() const {
   return get_rh_chords(voicing_style_);
 }
 
-std::size_t ChordVoicingEngine::quality_index(TriadQuality quality) {
-  return index_for(quality);
-}
-
 const std::string& ChordVoicingEngine::resolve_profile_id(std::string_view profile_id) const {
   return profile_for(profile_id).id;
 }
 
 const std::vector<ChordVoicingEngine::BassPattern>&
 ChordVoicingEngine::bass_options(TriadQuality quality, std::string_view profile_id) const {
-  return profile_for(profile_id).triads[quality_index(quality)].bass;
+  (void)quality;  // qualities share the canonical set for now
+  return profile_for(profile_id).triads.bass;
 }
 
 const std::vector<ChordVoicingEngine::RightHandPattern>&
 ChordVoicingEngine::right_hand_options(TriadQuality quality, std::string_view profile_id) const {
-  return profile_for(profile_id).triads[quality_index(quality)].right;
+  (void)quality;  // qualities share the canonical set for now
+  return profile_for(profile_id).triads.right;
 }
 
 const ChordVoicingEngine::BassPattern&
-ChordVoicingEngine::bass(TriadQuality quality, const std::string& id,
+ChordVoicingEngine::bass(TriadQuality quality, std::string_view id,
                          std::string_view profile_id) const {
   const auto& options = bass_options(quality, profile_id);
   auto it = std::find_if(options.begin(), options.end(),
-                         [&id](const BassPattern& pattern) { return pattern.id == id; });
+                         [id](const BassPattern& pattern) { return pattern.id == id; });
   if (it == options.end()) {
-    throw std::out_of_range("Unknown bass voicing id '" + id + "'");
+    throw std::out_of_range("Unknown bass voicing id '" + std::string(id) + "'");
   }
   return *it;
 }
 
 const ChordVoicingEngine::RightHandPattern&
-ChordVoicingEngine::right_hand(TriadQuality quality, const std::string& id,
+ChordVoicingEngine::right_hand(TriadQuality quality, std::string_view id,
                                std::string_view profile_id) const {
   const auto& options = right_hand_options(quality, profile_id);
   auto it = std::find_if(options.begin(), options.end(),
-                         [&id](const RHChord& pattern) { return pattern.id == id; });
+                         [id](const RHChord& pattern) { return pattern.id == id; });
   if (it == options.end()) {
-    throw std::out_of_range("Unknown right-hand voicing id '" + id + "'");
+    throw std::out_of_range("Unknown right-hand voicing id '" + std::string(id) + "'");
   }
   return *it;
 }
@@ -287,9 +296,9 @@ ChordVoicingEngine::right_hand(TriadQuality quality, const std::string& id,
 ChordVoicingEngine::Selection
 ChordVoicingEngine::pick_triad(TriadQuality quality,
                                std::uint64_t& rng_state,
-                               std::optional<std::string> preferred_right,
-                               std::optional<std::string> preferred_bass,
-                               std::optional<std::string> avoid_right,
+                               std::optional<std::string_view> preferred_right,
+                               std::optional<std::string_view> preferred_bass,
+                               std::optional<std::string_view> avoid_right,
                                std::string_view profile_id) const {
   const auto& basses = bass_options(quality, profile_id);
   const auto& rights = right_hand_options(quality, profile_id);
@@ -343,25 +352,41 @@ ChordVoicingEngine::pick_triad(TriadQuality quality,
 
 const ChordVoicingEngine::Profile&
 ChordVoicingEngine::profile_for(std::string_view profile_id) const {
-  if (!profile_id.empty()) {
-    auto it = profiles_.find(std::string(profile_id));
-    if (it != profiles_.end()) {
-      return it->second;
+  const auto& profiles = builtin_profiles();
+  if (profile_id.size() >= 4) {
+    // All builtin ids differ within their first 4 bytes, so a single word
+    // compare rejects non-matches before the full string match runs.
+    std::uint32_t probe;
+    std::memcpy(&probe, profile_id.data(), sizeof(probe));
+    for (const Profile& profile : profiles) {
+      std::uint32_t first4;
+      std::memcpy(&first4, profile.id.data(), sizeof(first4));
+      if (first4 == probe && profile.id == profile_id) {
+        return profile;
+      }
     }
   }
-
-  auto fallback = profiles_.find(default_profile_id());
-  if (fallback != profiles_.end()) {
-    return fallback->second;
-  }
-
-  throw std::runtime_error("ChordVoicingEngine: default profile is not registered");
+  // Unknown, short, or empty ids fall back to the default profile (first).
+  return profiles.front();
 }
 
 TriadQuality triad_quality_from_string(const std::string& quality) {
-  std::string lower = quality;
-  std::transform(lower.begin(), lower.end(), lower.begin(),
-                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  // Inputs are short ASCII keywords; lowercase 8 bytes at a time (SWAR:
+  // flag bytes in ['A','Z'] and OR in the 0x20 case bit) instead of a
+  // per-byte std::tolower loop, and compare without allocating.
+  char buf[16] = {};
+  const std::size_t n = std::min(quality.size(), sizeof(buf));
+  std::memcpy(buf, quality.data(), n);
+  for (std::size_t off = 0; off < sizeof(buf); off += 8) {
+    std::uint64_t v;
+    std::memcpy(&v, buf + off, 8);
+    const std::uint64_t ge_upper_a = v + 0x3f3f3f3f3f3f3f3fULL;
+    const std::uint64_t gt_upper_z = v + 0x2525252525252525ULL;
+    const std::uint64_t is_upper = (ge_upper_a & ~gt_upper_z) & 0x8080808080808080ULL;
+    v |= is_upper >> 2;
+    std::memcpy(buf + off, &v, 8);
+  }
+  std::string_view lower(buf, n);
   if (lower == "minor") {
     return TriadQuality::Minor;
   }
@@ -371,8 +396,8 @@ TriadQuality triad_quality_from_string(const std::string& quality) {
   return TriadQuality::Major;
 }
 
-std::string to_string(TriadQuality quality) {
-  return std::string(quality_name(quality));
+std::string_view to_string(TriadQuality quality) {
+  return quality_name(quality);
 }
 
 TriadQuality ChordVoicingEngine::degree_to_quality(int degree){
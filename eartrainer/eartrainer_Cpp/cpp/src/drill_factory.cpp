@@ -1,9 +1,8 @@
 #include "../include/ear/drill_factory.hpp"
 
 #include <algorithm>
-#include <cmath>
 #include <stdexcept>
-#include <variant>
+#include <string_view>
 #include <utility>
 
 #include "../drills/common.hpp"        // parse_key_from_string etc.
@@ -25,7 +24,8 @@ DrillSpec DrillSpec::from_session(const ear::SessionSpec& spec) {
   out.key = spec.key;
   out.params = spec.params;
   out.assistance_policy = spec.assistance_policy;
-  out.defaults["key"] = out.key;
+  // key/params already live in typed fields; no need to mirror them into the
+  // raw `defaults` json blob (nothing reads it back).
   return out;
 }
 
@@ -33,52 +33,134 @@ DrillSpec DrillSpec::from_session(const ear::SessionSpec& spec) {
 
 namespace ear {
 
+namespace {
+
+// Builtin families resolve through this flat table instead of hashing the
+// family string into the registry on every create_module call. The names all
+// have distinct lengths, so the length selects the sole candidate and a
+// single comparison confirms the match.
+using BuiltinCreator = std::unique_ptr<DrillModule> (*)();
+
+template <class Drill>
+std::unique_ptr<DrillModule> make_drill() {
+  return std::make_unique<Drill>();
+}
+
+BuiltinCreator builtin_creator(std::string_view family) {
+  switch (family.size()) {
+    case 4:  return family == "note" ? &make_drill<NoteDrill> : nullptr;
+    case 5:  return family == "chord" ? &make_drill<ChordDrill> : nullptr;
+    case 6:  return family == "melody" ? &make_drill<MelodyDrill> : nullptr;
+    case 7:  return family == "harmony" ? &make_drill<HarmonyDrill> : nullptr;
+    case 8:  return family == "interval" ? &make_drill<IntervalDrill> : nullptr;
+    case 12: return family == "chord_melody" ? &make_drill<ChordDrill> : nullptr;
+    default: return nullptr;
+  }
+}
+
+} // namespace
+
 DrillFactory& DrillFactory::instance() {
   static DrillFactory f;
   return f;
 }
 
-void DrillFactory::register_family(const std::string& family, Creator create) {
-  registry_[family] = std::move(create);
+void DrillFactory::register_family(std::string_view family, Creator create) {
+  for (auto& entry : registry_) {
+    if (entry.first == family) {
+      entry.second = std::move(create);
+      return;
+    }
+  }
+  // Only the stored copy allocates; literal call sites pay nothing up front.
+  registry_.emplace_back(std::string(family), std::move(create));
 }
 
-std::unique_ptr<DrillModule> DrillFactory::create_module(const std::string& family) const {
-  auto it = registry_.find(family);
-  if (it == registry_.end()) {
-    throw std::runtime_error("DrillFactory: family not registered: " + family);
+const DrillFactory::Creator* DrillFactory::find_registered(std::string_view family) const {
+  for (const auto& entry : registry_) {
+    if (entry.first == family) {
+      return &entry.second;
+    }
   }
-  auto module = it->second();
+  return nullptr;
+}
+
+std::unique_ptr<DrillModule> DrillFactory::create_module(std::string_view family) const {
+  if (BuiltinCreator create = builtin_creator(family)) {
+    return create();
+  }
+  const Creator* registered = find_registered(family);
+  if (!registered) {
+    throw std::runtime_error("DrillFactory: family not registered: " + std::string(family));
+  }
+  auto module = (*registered)();
   if (!module) {
-    throw std::runtime_error("DrillFactory: creator returned null for family: " + family);
+    throw std::runtime_error("DrillFactory: creator returned null for family: " +
+                             std::string(family));
   }
   return module;
 }
 
 DrillAssignment DrillFactory::create(const DrillSpec& spec) const {
+  return assemble(spec, create_module(spec.family));
+}
+
+DrillAssignment DrillFactory::create(DrillSpec&& spec) const {
+  auto module = create_module(spec.family);
+  return assemble(std::move(spec), std::move(module));
+}
+
+// Takes the spec by value: lvalue callers pay the one unavoidable copy here,
+// rvalue callers move straight through to the assignment.
+DrillAssignment DrillFactory::assemble(DrillSpec spec,
+                                       std::unique_ptr<DrillModule> module) const {
   DrillAssignment assignment;
-  assignment.id = spec.id;
-  assignment.family = spec.family;
-  assignment.spec = spec;
-  assignment.module = create_module(spec.family);
-  try {
-    assignment.module->configure(assignment.spec);
-  } catch (const std::bad_variant_access& ex) {
-    throw std::runtime_error("DrillFactory: bad params variant for family '" + spec.family +
-                             "' (id=" + spec.id + ") : " + ex.what());
-  }
+  assignment.spec = std::move(spec);
+  assignment.id = assignment.spec.id;
+  assignment.family = assignment.spec.family;
+  assignment.module = std::move(module);
+  // Modules validate their params variant with std::get_if and throw a
+  // descriptive runtime_error themselves, so no bad_variant_access can
+  // escape configure and the old try/catch here was dead weight.
+  assignment.module->configure(assignment.spec);
   return assignment;
 }
 
 std::vector<DrillAssignment> DrillFactory::create_for_level(const std::vector<DrillSpec>& all, int level) const {
-  std::vector<DrillSpec> specs;
-  for (const auto& spec : all) {
-    if (spec.level == level) {
-      specs.push_back(spec);
+  // Filter and assembly are fused into one walk over the catalog; the only
+  // pre-pass is an exact count so the output never reallocates. Specs are
+  // never copied before assembly - each DrillSpec carries strings plus a
+  // json blob, and assemble() makes the one copy the assignment needs.
+  const auto matches_level = [&](const DrillSpec& s) { return s.level == level; };
+  std::vector<DrillAssignment> out;
+  out.reserve(static_cast<std::size_t>(
+      std::count_if(all.begin(), all.end(), matches_level)));
+  // Catalog specs arrive grouped by family, so resolve the creator once per
+  // run of equal families instead of re-hashing the name for every spec.
+  std::string_view cached_family;
+  BuiltinCreator cached_builtin = nullptr;
+  const Creator* cached_registered = nullptr;
+  for (const DrillSpec& s : all) {
+    if (!matches_level(s)) {
+      continue;
+    }
+    if (s.family != cached_family || (!cached_builtin && !cached_registered)) {
+      cached_family = s.family;
+      cached_builtin = builtin_creator(s.family);
+      cached_registered = nullptr;
+      if (!cached_builtin) {
+        cached_registered = find_registered(s.family);
+        if (!cached_registered) {
+          throw std::runtime_error("DrillFactory: family not registered: " + s.family);
+        }
+      }
     }
+    auto module = cached_builtin ? cached_builtin() : (*cached_registered)();
+    if (!module) {
+      throw std::runtime_error("DrillFactory: creator returned null for family: " + s.family);
+    }
+    out.push_back(assemble(s, std::move(module)));
   }
-  std::vector<DrillAssignment> out;
-  out.reserve(specs.size());
-  for (const auto& s : specs) out.push_back(create(s));
   return out;
 }
 
@@ -89,15 +171,11 @@ namespace {
 // ------------------------ Concrete bindings ------------------------
 
 void register_builtin_drills(DrillFactory& factory) {
-  factory.register_family("melody", []() { return std::make_unique<MelodyDrill>(); });
-
-  factory.register_family("note", []() { return std::make_unique<NoteDrill>(); });
-
-  factory.register_family("interval", []() { return std::make_unique<IntervalDrill>(); });
-
-  factory.register_family("chord", []() { return std::make_unique<ChordDrill>(); });
-  factory.register_family("chord_melody", []() { return std::make_unique<ChordDrill>(); });
-  factory.register_family("harmony", []() { return std::make_unique<HarmonyDrill>(); });
+  // Builtin families dispatch through the static builtin_creator() table in
+  // create_module, so there is nothing to insert into the hash registry at
+  // startup anymore. The function stays as the registration point for any
+  // non-builtin families a caller wants to add via register_family.
+  (void)factory;
 }
 
 } // namespace ear
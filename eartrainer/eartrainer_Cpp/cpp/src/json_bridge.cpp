@@ -8,37 +8,38 @@
 #include <variant>
 
 #include "../drills/common.hpp"
+#include "../include/ear/chord_voicings.hpp"
 #include "../include/resources/drill_params.hpp"
 
 namespace ear::bridge {
 namespace {
 
-template <typename Setter>
-bool assign_if_present(const nlohmann::json& obj, const char* key, Setter&& setter) {
-  if (!obj.contains(key)) {
-    return false;
-  }
-  const auto& value = obj[key];
-  if (value.is_null()) {
-    return false;
-  }
-  setter(value);
-  return true;
+// Out-of-line throw path: the converters below run once per present key on
+// the hot parse loop, and the allocating message build only matters on
+// malformed input, so it is kept out of their bodies.
+[[noreturn]] void throw_field_error(const char* what, std::string_view key) {
+  throw std::invalid_argument(std::string(what) + " for field '" + std::string(key) + "'");
 }
 
 int json_to_int(const nlohmann::json& value, std::string_view key) {
-  if (value.is_number_integer()) {
-    return value.get<int>();
-  }
-  if (value.is_number_float()) {
-    return static_cast<int>(std::lround(value.get<double>()));
+  // Branch once on the stored tag; integers skip the float round-trip.
+  switch (value.type()) {
+    case nlohmann::json::value_t::number_integer:
+      return static_cast<int>(value.get_integer_unchecked());
+    case nlohmann::json::value_t::number_float: {
+      // Round half away from zero like lround, but as plain arithmetic the
+      // compiler can lower to a convert instruction instead of a libm call.
+      const double d = value.get_float_unchecked();
+      return static_cast<int>(d + (d >= 0.0 ? 0.5 : -0.5));
+    }
+    default:
+      throw_field_error("Expected integer", key);
   }
-  throw std::invalid_argument("Expected integer for field '" + std::string(key) + "'");
 }
 
 double json_to_double(const nlohmann::json& value, std::string_view key) {
   if (!value.is_number()) {
-    throw std::invalid_argument("Expected number for field '" + std::string(key) + "'");
+    throw_field_error("Expected number", key);
   }
   return value.get<double>();
 }
@@ -53,12 +54,12 @@ bool json_to_bool(const nlohmann::json& value, std::string_view key) {
       return v != 0;
     }
   }
-  throw std::invalid_argument("Expected bool for field '" + std::string(key) + "'");
+  throw_field_error("Expected bool", key);
 }
 
 std::vector<int> json_to_int_vector(const nlohmann::json& value, std::string_view key) {
   if (!value.is_array()) {
-    throw std::invalid_argument("Expected array<int> for field '" + std::string(key) + "'");
+    throw_field_error("Expected array<int>", key);
   }
   std::vector<int> out;
   const auto length = value.size();
@@ -71,7 +72,7 @@ std::vector<int> json_to_int_vector(const nlohmann::json& value, std::string_vie
 
 std::string json_to_string(const nlohmann::json& value, std::string_view key) {
   if (!value.is_string()) {
-    throw std::invalid_argument("Expected string for field '" + std::string(key) + "'");
+    throw_field_error("Expected string", key);
   }
   return value.get<std::string>();
 }
@@ -82,7 +83,7 @@ DrillInstrument json_to_instrument(const nlohmann::json& value, std::string_view
     case 0: return DrillInstrument::Piano;
     case 1: return DrillInstrument::Strings;
     default:
-      throw std::invalid_argument("Unknown instrument value for field '" + std::string(key) + "'");
+      throw_field_error("Unknown instrument value", key);
   }
 }
 
@@ -92,7 +93,7 @@ ChordDelivery json_to_delivery(const nlohmann::json& value, std::string_view key
     case 0: return ChordDelivery::Together;
     case 1: return ChordDelivery::Arpeggio;
     default:
-      throw std::invalid_argument("Unknown delivery value for field '" + std::string(key) + "'");
+      throw_field_error("Unknown delivery value", key);
   }
 }
 
@@ -109,7 +110,7 @@ std::optional<NoteParams::TonicAnchor> json_to_tonic_anchor(const nlohmann::json
     case 0: return NoteParams::TonicAnchor::Before;
     case 1: return NoteParams::TonicAnchor::After;
     default:
-      throw std::invalid_argument("Unknown tonic_anchor value for field '" + std::string(key) + "'");
+      throw_field_error("Unknown tonic_anchor value", key);
   }
 }
 
@@ -134,270 +135,283 @@ std::optional<bool> json_to_tristate_bool(const nlohmann::json& value, std::stri
   if (v == 1) {
     return true;
   }
-  throw std::invalid_argument("Unknown tri-state value for field '" + std::string(key) + "'");
+  throw_field_error("Unknown tri-state value", key);
 }
 
 nlohmann::json ints_to_json_array(const std::vector<int>& values) {
+  // Size is known up front, so the backing vector is allocated exactly once.
   nlohmann::json arr = nlohmann::json::array();
+  arr.reserve(values.size());
   for (int v : values) {
     arr.push_back(v);
   }
   return arr;
 }
 
+// The parse_* functions below walk the override object's members once and
+// dispatch on the keys that are actually present, instead of probing the map
+// once per known field. Typical overrides carry a handful of keys, so the
+// single forward pass replaces ~20 lookups with a few cheap comparisons.
+// Unknown keys are ignored, matching the old probe behaviour.
 NoteParams parse_note_params(const nlohmann::json& overrides) {
   NoteParams params;
-  assign_if_present(overrides, "allowed_degrees", [&](const nlohmann::json& value) {
-    params.degrees = json_to_int_vector(value, "allowed_degrees");
-  });
-  assign_if_present(overrides, "avoid_repeat", [&](const nlohmann::json& value) {
-    params.avoid_repeat = json_to_bool(value, "avoid_repeat");
-  });
-  assign_if_present(overrides, "range_below_semitones", [&](const nlohmann::json& value) {
-    params.range_down = json_to_int(value, "range_below_semitones");
-  });
-  assign_if_present(overrides, "range_above_semitones", [&](const nlohmann::json& value) {
-    params.range_up = json_to_int(value, "range_above_semitones");
-  });
-  assign_if_present(overrides, "inst", [&](const nlohmann::json& value) {
-    params.inst = json_to_instrument(value, "inst");
-  });
-  assign_if_present(overrides, "tempo_bpm", [&](const nlohmann::json& value) {
-    params.bpm = json_to_int(value, "tempo_bpm");
-  });
-  assign_if_present(overrides, "note_beats", [&](const nlohmann::json& value) {
-    params.note_beats = json_to_double(value, "note_beats");
-  });
-  assign_if_present(overrides, "program", [&](const nlohmann::json& value) {
-    params.program = json_to_int(value, "program");
-  });
-  assign_if_present(overrides, "velocity", [&](const nlohmann::json& value) {
-    params.velocity = json_to_int(value, "velocity");
-  });
-  assign_if_present(overrides, "use_pathway", [&](const nlohmann::json& value) {
-    params.pathway = json_to_bool(value, "use_pathway");
-  });
-  assign_if_present(overrides, "pathway_repeat_lead", [&](const nlohmann::json& value) {
-    params.pathway_repeat_lead = json_to_bool(value, "pathway_repeat_lead");
-  });
-  assign_if_present(overrides, "pathway_beats", [&](const nlohmann::json& value) {
-    params.pathway_beats = json_to_double(value, "pathway_beats");
-  });
-  assign_if_present(overrides, "pathway_rest", [&](const nlohmann::json& value) {
-    params.pathway_rest = json_to_double(value, "pathway_rest");
-  });
-  assign_if_present(overrides, "note_step_beats", [&](const nlohmann::json& value) {
-    params.note_step_beats = json_to_double(value, "note_step_beats");
-  });
-  assign_if_present(overrides, "note_tempo_bpm", [&](const nlohmann::json& value) {
-    params.note_tempo_bpm = json_to_int(value, "note_tempo_bpm");
-  });
-  assign_if_present(overrides, "use_anchor", [&](const nlohmann::json& value) {
-    params.use_anchor = json_to_bool(value, "use_anchor");
-  });
-  assign_if_present(overrides, "tonic_anchor", [&](const nlohmann::json& value) {
-    params.tonic_anchor = json_to_tonic_anchor(value, "tonic_anchor");
-  });
-  assign_if_present(overrides, "tonic_anchor_include_octave", [&](const nlohmann::json& value) {
-    params.tonic_anchor_include_octave = json_to_bool(value, "tonic_anchor_include_octave");
-  });
+  for (const auto& [key, value] : overrides.get_object()) {
+    if (value.is_null()) {
+      continue;
+    }
+    if (key == "allowed_degrees") {
+      params.degrees = json_to_int_vector(value, key);
+    } else if (key == "avoid_repeat") {
+      params.avoid_repeat = json_to_bool(value, key);
+    } else if (key == "range_below_semitones") {
+      params.range_down = json_to_int(value, key);
+    } else if (key == "range_above_semitones") {
+      params.range_up = json_to_int(value, key);
+    } else if (key == "inst") {
+      params.inst = json_to_instrument(value, key);
+    } else if (key == "tempo_bpm") {
+      params.bpm = json_to_int(value, key);
+    } else if (key == "note_beats") {
+      params.note_beats = json_to_double(value, key);
+    } else if (key == "program") {
+      params.program = json_to_int(value, key);
+    } else if (key == "velocity") {
+      params.velocity = json_to_int(value, key);
+    } else if (key == "use_pathway") {
+      params.pathway = json_to_bool(value, key);
+    } else if (key == "pathway_repeat_lead") {
+      params.pathway_repeat_lead = json_to_bool(value, key);
+    } else if (key == "pathway_beats") {
+      params.pathway_beats = json_to_double(value, key);
+    } else if (key == "pathway_rest") {
+      params.pathway_rest = json_to_double(value, key);
+    } else if (key == "note_step_beats") {
+      params.note_step_beats = json_to_double(value, key);
+    } else if (key == "note_tempo_bpm") {
+      params.note_tempo_bpm = json_to_int(value, key);
+    } else if (key == "use_anchor") {
+      params.use_anchor = json_to_bool(value, key);
+    } else if (key == "tonic_anchor") {
+      params.tonic_anchor = json_to_tonic_anchor(value, key);
+    } else if (key == "tonic_anchor_include_octave") {
+      params.tonic_anchor_include_octave = json_to_bool(value, key);
+    }
+  }
   return params;
 }
 
 IntervalParams parse_interval_params(const nlohmann::json& overrides) {
   IntervalParams params;
-  assign_if_present(overrides, "tempo_bpm", [&](const nlohmann::json& value) {
-    params.bpm = json_to_int(value, "tempo_bpm");
-  });
-  assign_if_present(overrides, "note_beat", [&](const nlohmann::json& value) {
-    params.note_beat = json_to_double(value, "note_beat");
-  });
-  assign_if_present(overrides, "program", [&](const nlohmann::json& value) {
-    params.program = json_to_int(value, "program");
-  });
-  assign_if_present(overrides, "allowed_bottom_degrees", [&](const nlohmann::json& value) {
-    params.allowed_bottom_degrees = json_to_int_vector(value, "allowed_bottom_degrees");
-  });
-  assign_if_present(overrides, "allowed_degrees", [&](const nlohmann::json& value) {
-    params.allowed_degrees = json_to_int_vector(value, "allowed_degrees");
-  });
-  assign_if_present(overrides, "allowed_sizes", [&](const nlohmann::json& value) {
-    params.intervals = json_to_int_vector(value, "allowed_sizes");
-  });
-  assign_if_present(overrides, "avoid_repeat", [&](const nlohmann::json& value) {
-    params.avoid_repeat = json_to_bool(value, "avoid_repeat");
-  });
-  assign_if_present(overrides, "range_semitones", [&](const nlohmann::json& value) {
-    params.range_semitones = json_to_int(value, "range_semitones");
-  });
-  assign_if_present(overrides, "velocity", [&](const nlohmann::json& value) {
-    params.velocity = json_to_int(value, "velocity");
-  });
-  assign_if_present(overrides, "inst", [&](const nlohmann::json& value) {
-    params.inst = json_to_instrument(value, "inst");
-  });
-  assign_if_present(overrides, "cluster_ids", [&](const nlohmann::json& value) {
-    params.cluster_ids = json_to_int_vector(value, "cluster_ids");
-  });
-  assign_if_present(overrides, "add_helper", [&](const nlohmann::json& value) {
-    params.helper = json_to_bool(value, "add_helper");
-  });
+  for (const auto& [key, value] : overrides.get_object()) {
+    if (value.is_null()) {
+      continue;
+    }
+    if (key == "tempo_bpm") {
+      params.bpm = json_to_int(value, key);
+    } else if (key == "note_beat") {
+      params.note_beat = json_to_double(value, key);
+    } else if (key == "program") {
+      params.program = json_to_int(value, key);
+    } else if (key == "allowed_bottom_degrees") {
+      params.allowed_bottom_degrees = json_to_int_vector(value, key);
+    } else if (key == "allowed_degrees") {
+      params.allowed_degrees = json_to_int_vector(value, key);
+    } else if (key == "allowed_sizes") {
+      params.intervals = json_to_int_vector(value, key);
+    } else if (key == "avoid_repeat") {
+      params.avoid_repeat = json_to_bool(value, key);
+    } else if (key == "range_semitones") {
+      params.range_semitones = json_to_int(value, key);
+    } else if (key == "velocity") {
+      params.velocity = json_to_int(value, key);
+    } else if (key == "inst") {
+      params.inst = json_to_instrument(value, key);
+    } else if (key == "cluster_ids") {
+      params.cluster_ids = json_to_int_vector(value, key);
+    } else if (key == "add_helper") {
+      params.helper = json_to_bool(value, key);
+    }
+  }
   return params;
 }
 
 MelodyParams parse_melody_params(const nlohmann::json& overrides) {
   MelodyParams params;
-  assign_if_present(overrides, "tempo_bpm", [&](const nlohmann::json& value) {
-    params.bpm = json_to_int(value, "tempo_bpm");
-  });
-  assign_if_present(overrides, "program", [&](const nlohmann::json& value) {
-    params.program = json_to_int(value, "program");
-  });
-  assign_if_present(overrides, "melody_lengths", [&](const nlohmann::json& value) {
-    params.length = json_to_int_vector(value, "melody_lengths");
-  });
-  assign_if_present(overrides, "melody_max_step", [&](const nlohmann::json& value) {
-    params.max_step = json_to_int(value, "melody_max_step");
-  });
-  assign_if_present(overrides, "avoid_repeat", [&](const nlohmann::json& value) {
-    params.avoid_repeat = json_to_bool(value, "avoid_repeat");
-  });
-  assign_if_present(overrides, "range_below_semitones", [&](const nlohmann::json& value) {
-    params.range_down = json_to_int(value, "range_below_semitones");
-  });
-  assign_if_present(overrides, "range_above_semitones", [&](const nlohmann::json& value) {
-    params.range_up = json_to_int(value, "range_above_semitones");
-  });
-  assign_if_present(overrides, "note_beat", [&](const nlohmann::json& value) {
-    params.note_beat = json_to_double(value, "note_beat");
-  });
-  assign_if_present(overrides, "velocity", [&](const nlohmann::json& value) {
-    params.velocity = json_to_int(value, "velocity");
-  });
-  assign_if_present(overrides, "inst", [&](const nlohmann::json& value) {
-    params.inst = json_to_instrument(value, "inst");
-  });
+  for (const auto& [key, value] : overrides.get_object()) {
+    if (value.is_null()) {
+      continue;
+    }
+    if (key == "tempo_bpm") {
+      params.bpm = json_to_int(value, key);
+    } else if (key == "program") {
+      params.program = json_to_int(value, key);
+    } else if (key == "melody_lengths") {
+      params.length = json_to_int_vector(value, key);
+    } else if (key == "melody_max_step") {
+      params.max_step = json_to_int(value, key);
+    } else if (key == "avoid_repeat") {
+      params.avoid_repeat = json_to_bool(value, key);
+    } else if (key == "range_below_semitones") {
+      params.range_down = json_to_int(value, key);
+    } else if (key == "range_above_semitones") {
+      params.range_up = json_to_int(value, key);
+    } else if (key == "note_beat") {
+      params.note_beat = json_to_double(value, key);
+    } else if (key == "velocity") {
+      params.velocity = json_to_int(value, key);
+    } else if (key == "inst") {
+      params.inst = json_to_instrument(value, key);
+    }
+  }
   return params;
 }
 
+void apply_training_root_overrides(ChordParams& params, const nlohmann::json& root) {
+  for (const auto& [key, value] : root.get_object()) {
+    if (value.is_null()) {
+      continue;
+    }
+    if (key == "enabled") {
+      params.play_root.enabled = json_to_bool(value, "training_root.enabled");
+    } else if (key == "delay_beats") {
+      params.play_root.delay_beats = json_to_double(value, "training_root.delay_beats");
+    } else if (key == "dur_beats") {
+      params.play_root.dur_beats = json_to_double(value, "training_root.dur_beats");
+    } else if (key == "channel") {
+      params.play_root.channel = json_to_int(value, "training_root.channel");
+    } else if (key == "program") {
+      params.play_root.program = json_to_int(value, "training_root.program");
+    } else if (key == "velocity") {
+      params.play_root.velocity = json_to_int(value, "training_root.velocity");
+    }
+  }
+}
+
 ChordParams parse_chord_params(const nlohmann::json& overrides) {
   ChordParams params;
-  assign_if_present(overrides, "allowed_degrees", [&](const nlohmann::json& value) {
-    params.degrees = json_to_int_vector(value, "allowed_degrees");
-  });
-  assign_if_present(overrides, "inst", [&](const nlohmann::json& value) {
-    params.inst = json_to_instrument(value, "inst");
-  });
-  assign_if_present(overrides, "delivery", [&](const nlohmann::json& value) {
-    params.delivery = json_to_delivery(value, "delivery");
-  });
-  assign_if_present(overrides, "allowed_top_degrees", [&](const nlohmann::json& value) {
-    params.allowed_top_degrees = json_to_int_vector(value, "allowed_top_degrees");
-  });
-  assign_if_present(overrides, "sequence_lengths", [&](const nlohmann::json& value) {
-    params.sequence_lengths = json_to_int_vector(value, "sequence_lengths");
-  });
-  assign_if_present(overrides, "avoid_repeat", [&](const nlohmann::json& value) {
-    params.avoid_repeat = json_to_bool(value, "avoid_repeat");
-  });
-  assign_if_present(overrides, "chord_avoid_repeat", [&](const nlohmann::json& value) {
-    params.chord_avoid_repeat = json_to_tristate_bool(value, "chord_avoid_repeat");
-  });
-  assign_if_present(overrides, "range_semitones", [&](const nlohmann::json& value) {
-    params.range_semitones = json_to_int(value, "range_semitones");
-  });
-  assign_if_present(overrides, "add_seventh", [&](const nlohmann::json& value) {
-    params.add_seventh = json_to_bool(value, "add_seventh");
-  });
-  assign_if_present(overrides, "tempo_bpm", [&](const nlohmann::json& value) {
-    params.bpm = json_to_int(value, "tempo_bpm");
-  });
-  assign_if_present(overrides, "right_voicing_id", [&](const nlohmann::json& value) {
-    params.right_voicing_id = json_to_string(value, "right_voicing_id");
-  });
-  assign_if_present(overrides, "bass_voicing_id", [&](const nlohmann::json& value) {
-    params.bass_voicing_id = json_to_string(value, "bass_voicing_id");
-  });
-  assign_if_present(overrides, "voicing_profile", [&](const nlohmann::json& value) {
-    const std::string profile = json_to_string(value, "voicing_profile");
-    if (profile.empty()) {
-      params.voicing_profile.reset();
-    } else {
-      params.voicing_profile = profile;
-    }
-  });
-  // // assign_if_present(overrides, "prompt_split_tracks", [&](const nlohmann::json& value) {
-  // //   params.prompt_split_tracks = json_to_bool(value, "prompt_split_tracks");
-  // // });
-  // // assign_if_present(overrides, "prompt_program", [&](const nlohmann::json& value) {
-  // //   params.prompt_program = json_to_int(value, "prompt_program");
-  // // });
-  // // assign_if_present(overrides, "prompt_channel", [&](const nlohmann::json& value) {
-  // //   params.prompt_channel = json_to_int(value, "prompt_channel");
-  // // });
-  // assign_if_present(overrides, "right_program", [&](const nlohmann::json& value) {
-  //   params.right_program = json_to_int(value, "right_program");
-  // });
-  assign_if_present(overrides, "right_channel", [&](const nlohmann::json& value) {
-    params.right_channel = json_to_int(value, "right_channel");
-  });
-  // assign_if_present(overrides, "bass_program", [&](const nlohmann::json& value) {
-  //   params.bass_program = json_to_int(value, "bass_program");
-  // });
-  assign_if_present(overrides, "bass_channel", [&](const nlohmann::json& value) {
-    params.bass_channel = json_to_int(value, "bass_channel");
-  });
-  assign_if_present(overrides, "velocity", [&](const nlohmann::json& value) {
-    params.velocity = json_to_int(value, "velocity");
-  });
-  assign_if_present(overrides, "dur_beats", [&](const nlohmann::json& value) {
-    params.dur_beats = json_to_double(value, "dur_beats");
-  });
-  // assign_if_present(overrides, "duration_ms", [&](const nlohmann::json& value) {
-  //   params.duration_ms = json_to_int(value, "duration_ms");
-  // });
-  assign_if_present(overrides, "strum_step_ms", [&](const nlohmann::json& value) {
-    params.strum_step_ms = json_to_int(value, "strum_step_ms");
-  });
-  assign_if_present(overrides, "voice_leading_continuity", [&](const nlohmann::json& value) {
-    params.voice_leading_continuity = json_to_bool(value, "voice_leading_continuity");
-  });
-
-  const nlohmann::json* training_root = nullptr;
-  if (overrides.contains("training_root") && overrides["training_root"].is_object()) {
-    training_root = &overrides["training_root"];
-  }
-
-  auto assign_training = [&](const char* dotted, const char* nested_key, auto&& setter) {
-    if (assign_if_present(overrides, dotted, setter)) {
-      return;
+  // The chord schema is the widest (~25 keys), so beyond the single member
+  // walk the key length picks the handful of candidates first - the same
+  // static keying builtin_creator uses for family names - and at most two
+  // comparisons confirm the match within a length bucket.
+  //
+  // The "training_root" nested object sorts before its dotted
+  // "training_root.*" spellings in the member map, so applying the nested
+  // block as it is encountered and letting the dotted keys overwrite
+  // afterwards preserves the old dotted-wins precedence.
+  for (const auto& [key, value] : overrides.get_object()) {
+    if (value.is_null()) {
+      continue;
     }
-    if (training_root) {
-      assign_if_present(*training_root, nested_key, setter);
+    switch (key.size()) {
+      case 4:
+        if (key == "inst") params.inst = json_to_instrument(value, key);
+        break;
+      case 8:
+        if (key == "delivery") {
+          params.delivery = json_to_delivery(value, key);
+        } else if (key == "velocity") {
+          params.velocity = json_to_int(value, key);
+        }
+        break;
+      case 9:
+        if (key == "tempo_bpm") {
+          params.bpm = json_to_int(value, key);
+        } else if (key == "dur_beats") {
+          params.dur_beats = json_to_double(value, key);
+        }
+        break;
+      case 11:
+        if (key == "add_seventh") params.add_seventh = json_to_bool(value, key);
+        break;
+      case 12:
+        if (key == "avoid_repeat") {
+          params.avoid_repeat = json_to_bool(value, key);
+        } else if (key == "bass_channel") {
+          params.bass_channel = json_to_int(value, key);
+        }
+        break;
+      case 13:
+        if (key == "right_channel") {
+          params.right_channel = json_to_int(value, key);
+        } else if (key == "strum_step_ms") {
+          params.strum_step_ms = json_to_int(value, key);
+        } else if (key == "training_root") {
+          if (value.is_object()) {
+            apply_training_root_overrides(params, value);
+          }
+        }
+        break;
+      case 15:
+        if (key == "allowed_degrees") {
+          params.degrees = json_to_int_vector(value, key);
+        } else if (key == "range_semitones") {
+          params.range_semitones = json_to_int(value, key);
+        } else if (key == "bass_voicing_id") {
+          params.bass_voicing_id = json_to_string(value, key);
+        } else if (key == "voicing_profile") {
+          if (!value.is_string()) {
+            throw_field_error("Expected string", key);
+          }
+          // Observe in place; only a nonempty profile is copied into the
+          // optional, so the empty-reset case allocates nothing.
+          const std::string& profile = value.get_string();
+          if (profile.empty()) {
+            params.voicing_profile.reset();
+          } else {
+            params.voicing_profile = profile;
+          }
+        }
+        break;
+      case 16:
+        if (key == "sequence_lengths") {
+          params.sequence_lengths = json_to_int_vector(value, key);
+        } else if (key == "right_voicing_id") {
+          params.right_voicing_id = json_to_string(value, key);
+        }
+        break;
+      case 18:
+        if (key == "chord_avoid_repeat") {
+          params.chord_avoid_repeat = json_to_tristate_bool(value, key);
+        }
+        break;
+      case 19:
+        if (key == "allowed_top_degrees") {
+          params.allowed_top_degrees = json_to_int_vector(value, key);
+        }
+        break;
+      case 21:
+        if (key == "training_root.enabled") {
+          params.play_root.enabled = json_to_bool(value, key);
+        } else if (key == "training_root.channel") {
+          params.play_root.channel = json_to_int(value, key);
+        } else if (key == "training_root.program") {
+          params.play_root.program = json_to_int(value, key);
+        }
+        break;
+      case 22:
+        if (key == "training_root.velocity") {
+          params.play_root.velocity = json_to_int(value, key);
+        }
+        break;
+      case 23:
+        if (key == "training_root.dur_beats") {
+          params.play_root.dur_beats = json_to_double(value, key);
+        }
+        break;
+      case 24:
+        if (key == "voice_leading_continuity") {
+          params.voice_leading_continuity = json_to_bool(value, key);
+        }
+        break;
+      case 25:
+        if (key == "training_root.delay_beats") {
+          params.play_root.delay_beats = json_to_double(value, key);
+        }
+        break;
+      default:
+        break;
     }
-  };
-
-  assign_training("training_root.enabled", "enabled", [&](const nlohmann::json& value) {
-    params.play_root.enabled = json_to_bool(value, "training_root.enabled");
-  });
-  assign_training("training_root.delay_beats", "delay_beats", [&](const nlohmann::json& value) {
-    params.play_root.delay_beats = json_to_double(value, "training_root.delay_beats");
-  });
-  assign_training("training_root.dur_beats", "dur_beats", [&](const nlohmann::json& value) {
-    params.play_root.dur_beats = json_to_double(value, "training_root.dur_beats");
-  });
-  assign_training("training_root.channel", "channel", [&](const nlohmann::json& value) {
-    params.play_root.channel = json_to_int(value, "training_root.channel");
-  });
-  assign_training("training_root.program", "program", [&](const nlohmann::json& value) {
-    params.play_root.program = json_to_int(value, "training_root.program");
-  });
-  assign_training("training_root.velocity", "velocity", [&](const nlohmann::json& value) {
-    params.play_root.velocity = json_to_int(value, "training_root.velocity");
-  });
-  // assign_training("training_root.duration_ms", "duration_ms", [&](const nlohmann::json& value) {
-  //   params.play_root.duration_ms = json_to_int(value, "training_root.duration_ms");
-  // });
+  }
   return params;
 }
 
@@ -405,17 +419,26 @@ DrillParams params_from_json(const std::string& kind, const nlohmann::json& over
   if (!overrides.is_object()) {
     throw std::invalid_argument("params must be an object");
   }
-  if (kind == "note") {
-    return DrillParams{parse_note_params(overrides)};
-  }
-  if (kind == "interval") {
-    return DrillParams{parse_interval_params(overrides)};
-  }
-  if (kind == "melody") {
-    return DrillParams{parse_melody_params(overrides)};
-  }
-  if (kind == "chord" || kind == "chord_melody") {
-    return DrillParams{parse_chord_params(overrides)};
+  // Kind names all differ in length (the same property builtin_creator keys
+  // on), so the length picks the sole candidate and one comparison confirms.
+  switch (kind.size()) {
+    case 4:
+      if (kind == "note") return DrillParams{parse_note_params(overrides)};
+      break;
+    case 5:
+      if (kind == "chord") return DrillParams{parse_chord_params(overrides)};
+      break;
+    case 6:
+      if (kind == "melody") return DrillParams{parse_melody_params(overrides)};
+      break;
+    case 8:
+      if (kind == "interval") return DrillParams{parse_interval_params(overrides)};
+      break;
+    case 12:
+      if (kind == "chord_melody") return DrillParams{parse_chord_params(overrides)};
+      break;
+    default:
+      break;
   }
   // Unknown drill kinds fall back to defaults.
   return DrillParams{};
@@ -437,18 +460,17 @@ int delivery_to_int(ChordDelivery delivery) {
   }
 }
 
+// Both encoders collapse to a single select (absent -> -1) that the
+// compiler lowers branch-free; they run once per field in the chord
+// serialization path.
 int tonic_anchor_to_int(const std::optional<NoteParams::TonicAnchor>& anchor) {
-  if (!anchor.has_value()) {
-    return -1;
-  }
-  return (*anchor == NoteParams::TonicAnchor::Before) ? 0 : 1;
+  return anchor.has_value()
+             ? static_cast<int>(*anchor != NoteParams::TonicAnchor::Before)
+             : -1;
 }
 
 int optional_bool_to_int(const std::optional<bool>& value) {
-  if (!value.has_value()) {
-    return -1;
-  }
-  return value.value() ? 1 : 0;
+  return value.has_value() ? static_cast<int>(*value) : -1;
 }
 
 nlohmann::json note_params_to_json(const NoteParams& params) {
@@ -544,26 +566,23 @@ nlohmann::json chord_params_to_json(const ChordParams& params) {
 }
 
 nlohmann::json params_to_json(const DrillParams& params) {
-  if (std::holds_alternative<std::monostate>(params)) {
-    return nlohmann::json::object();
-  }
-  if (const auto* note = std::get_if<NoteParams>(&params)) {
-    return note_params_to_json(*note);
-  }
-  if (const auto* interval = std::get_if<IntervalParams>(&params)) {
-    return interval_params_to_json(*interval);
-  }
-  if (const auto* melody = std::get_if<MelodyParams>(&params)) {
-    return melody_params_to_json(*melody);
-  }
-  if (const auto* chord = std::get_if<ChordParams>(&params)) {
-    return chord_params_to_json(*chord);
+  // Dispatch on the stored index so the compiler emits one jump table
+  // instead of four dependent get_if probes.
+  switch (params.index()) {
+    case 1: return note_params_to_json(std::get<1>(params));
+    case 2: return interval_params_to_json(std::get<2>(params));
+    case 3: return melody_params_to_json(std::get<3>(params));
+    case 4: return chord_params_to_json(std::get<4>(params));
+    default: return nlohmann::json::object();  // monostate
   }
-  return nlohmann::json::object();
 }
 
 // Convert the legacy PromptPlan (sequential notes with dur_ms) into a
 // "midi-clip" JSON object ready for direct playback.
+// Ternary clamps compile to cmov, so the per-note velocity/duration fixup
+// stays branchless under arbitrary user input.
+inline int clamp7(int v) { return v < 0 ? 0 : (v > 127 ? 127 : v); }
+
 nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
   if (plan.modality == "midi-clip" && plan.midi_clip.has_value()) {
     nlohmann::json json_plan = nlohmann::json::object();
@@ -574,7 +593,9 @@ nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
 
   const int tempo = plan.tempo_bpm.has_value() ? plan.tempo_bpm.value() : 90;
   const int ppq = 480;
-  const double ticks_per_ms = (tempo * ppq) / 60000.0; // ticks = dur_ms * ticks_per_ms
+  // ticks = dur_ms * ticks_per_ms; grouping the constant factor lets the
+  // compiler fold ppq/60000 so the per-call division disappears.
+  const double ticks_per_ms = tempo * (ppq / 60000.0);
 
   nlohmann::json clip = nlohmann::json::object();
   clip["format"] = "midi-clip/v1";
@@ -586,12 +607,19 @@ nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
   track["channel"] = 0;
   track["program"] = 0; // GM Acoustic Grand
   nlohmann::json events = nlohmann::json::array();
+  // Each note emits at most an on and an off (held notes release later but
+  // still once), so 2N bounds the event count.
+  events.reserve(plan.notes.size() * 2);
 
   int t = 0; // timeline in ticks
   std::vector<int> held;
+  held.reserve(plan.notes.size());
 
   if (plan.modality == "midi_block") {
-    // Simultaneous note_on at t=0; individual offs based on dur_ms
+    // Simultaneous note_on at t=0; individual offs based on dur_ms.
+    // Track the max off time while emitting instead of re-scanning the
+    // events array (which cost a map lookup + string compare per event).
+    int max_off = 0;
     for (const auto& n : plan.notes) {
       int dur_ticks = static_cast<int>(std::lround(n.dur_ms * ticks_per_ms));
       if (n.pitch < 0 || dur_ticks <= 0) {
@@ -602,23 +630,16 @@ nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
       on["t"] = 0;
       on["type"] = "note_on";
       on["note"] = n.pitch;
-      on["vel"] = std::max(0, std::min(127, vel));
-      events.push_back(on);
+      on["vel"] = clamp7(vel);
+      events.push_back(std::move(on));
 
+      const int off_ticks = dur_ticks < 1 ? 1 : dur_ticks;
       nlohmann::json off = nlohmann::json::object();
-      off["t"] = std::max(1, dur_ticks);
+      off["t"] = off_ticks;
       off["type"] = "note_off";
       off["note"] = n.pitch;
-      events.push_back(off);
-    }
-    t = 0;
-    // length ticks = max off time
-    int max_off = 0;
-    for (std::size_t i = 0; i < events.size(); ++i) {
-      const auto& ev = events[i];
-      if (ev["type"].get<std::string>() == "note_off") {
-        max_off = std::max(max_off, ev["t"].get<int>());
-      }
+      events.push_back(std::move(off));
+      max_off = std::max(max_off, off_ticks);
     }
     t = max_off;
   } else {
@@ -633,20 +654,21 @@ nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
       on["t"] = t;
       on["type"] = "note_on";
       on["note"] = n.pitch;
-      on["vel"] = std::max(0, std::min(127, vel));
-      events.push_back(on);
+      on["vel"] = clamp7(vel);
+      events.push_back(std::move(on));
 
+      const int step_ticks = dur_ticks < 1 ? 1 : dur_ticks;
       bool tie_forward = n.tie.has_value() && n.tie.value();
       if (!tie_forward) {
         nlohmann::json off = nlohmann::json::object();
-        off["t"] = t + std::max(1, dur_ticks);
+        off["t"] = t + step_ticks;
         off["type"] = "note_off";
         off["note"] = n.pitch;
-        events.push_back(off);
+        events.push_back(std::move(off));
       } else {
         held.push_back(n.pitch);
       }
-      t += std::max(1, dur_ticks);
+      t += step_ticks;
     }
     // Ensure all held notes are released at the end
     for (int pitch : held) {
@@ -654,33 +676,34 @@ nlohmann::json prompt_plan_to_json_impl(const PromptPlan& plan) {
       off["t"] = t;
       off["type"] = "note_off";
       off["note"] = pitch;
-      events.push_back(off);
+      events.push_back(std::move(off));
     }
   }
 
-  track["events"] = events;
+  track["events"] = std::move(events);
   clip["length_ticks"] = t;
   nlohmann::json tracks = nlohmann::json::array();
-  tracks.push_back(track);
-  clip["tracks"] = tracks;
+  tracks.push_back(std::move(track));
+  clip["tracks"] = std::move(tracks);
 
   nlohmann::json json_plan = nlohmann::json::object();
   json_plan["modality"] = "midi-clip";
-  json_plan["midi_clip"] = clip;
+  json_plan["midi_clip"] = std::move(clip);
   return json_plan;
 }
 
 PromptPlan prompt_from_json_impl(const nlohmann::json& json_plan) {
   // Legacy loader retained only for round-trips if needed. Not used by Python UI.
   PromptPlan plan;
-  if (json_plan.contains("modality")) {
-    plan.modality = json_plan["modality"].get<std::string>();
+  if (const auto* modality = json_plan.find_member("modality")) {
+    plan.modality = modality->get<std::string>();
   } else {
     plan.modality = "midi-clip";
   }
-  if (plan.modality == "midi-clip" && json_plan.contains("midi_clip") &&
-      !json_plan["midi_clip"].is_null()) {
-    plan.midi_clip = json_plan["midi_clip"];
+  if (plan.modality == "midi-clip") {
+    if (const auto* clip = json_plan.find_member("midi_clip"); clip && !clip->is_null()) {
+      plan.midi_clip = *clip;
+    }
   }
   // We no longer reconstruct sequential notes from midi-clip here.
   return plan;
@@ -700,450 +723,531 @@ TypedPayload typed_from_json(const nlohmann::json& json_payload) {
   return payload;
 }
 
+// Rvalue overload: steals the payload subtree - an arbitrary json tree that
+// the const path above has to deep-copy node by node.
+TypedPayload typed_from_json(nlohmann::json&& json_payload) {
+  TypedPayload payload;
+  payload.type = std::as_const(json_payload)["type"].get<std::string>();
+  auto& obj = json_payload.get_object();
+  if (auto it = obj.find("payload"); it != obj.end()) {
+    payload.payload = std::move(it->second);
+  }
+  return payload;
+}
+
 // ----------------------------------------------------------------------------
 // V2 Answer payload (variant) JSON helpers
 // ----------------------------------------------------------------------------
+static nlohmann::json chord_answer_to_json(const ChordAnswerV2& a) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "chord";
+  auto to_int_array = [](const std::vector<int>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (int v : values) { arr.push_back(v); }
+    return arr;
+  };
+  auto to_optional_array = [](const std::vector<std::optional<int>>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (const auto& v : values) {
+      arr.push_back(v.has_value() ? nlohmann::json(v.value()) : nlohmann::json(nullptr));
+    }
+    return arr;
+  };
+  auto to_bool_array = [](const std::vector<bool>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (bool v : values) { arr.push_back(v); }
+    return arr;
+  };
+  j["root_degrees"] = to_int_array(a.root_degrees);
+  j["bass_deg"] = to_optional_array(a.bass_deg);
+  j["top_deg"] = to_optional_array(a.top_deg);
+  j["expect_root"] = to_bool_array(a.expect_root);
+  j["expect_bass"] = to_bool_array(a.expect_bass);
+  j["expect_top"] = to_bool_array(a.expect_top);
+  return j;
+}
+
+static nlohmann::json melody_answer_to_json(const MelodyAnswerV2& a) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "melody";
+  nlohmann::json arr = nlohmann::json::array();
+  arr.reserve(a.melody.size());
+  for (int v : a.melody) { arr.push_back(v); }
+  j["melody"] = std::move(arr);
+  return j;
+}
+
+static nlohmann::json harmony_answer_to_json(const HarmonyAnswerV2& a) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "harmony";
+  nlohmann::json arr = nlohmann::json::array();
+  arr.reserve(a.notes.size());
+  for (int v : a.notes) { arr.push_back(v); }
+  j["notes"] = std::move(arr);
+  return j;
+}
+
 static nlohmann::json answer_payload_v2_to_json(const AnswerPayloadV2& payload) {
-  return std::visit(
-      [](const auto& a) -> nlohmann::json {
-        using T = std::decay_t<decltype(a)>;
-        nlohmann::json j = nlohmann::json::object();
-        if constexpr (std::is_same_v<T, ChordAnswerV2>) {
-          j["type"] = "chord";
-          auto to_int_array = [](const std::vector<int>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int v : values) { arr.push_back(v); }
-            return arr;
-          };
-          auto to_optional_array = [](const std::vector<std::optional<int>>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& v : values) {
-              arr.push_back(v.has_value() ? nlohmann::json(v.value()) : nlohmann::json(nullptr));
-            }
-            return arr;
-          };
-          auto to_bool_array = [](const std::vector<bool>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (bool v : values) { arr.push_back(v); }
-            return arr;
-          };
-          j["root_degrees"] = to_int_array(a.root_degrees);
-          j["bass_deg"] = to_optional_array(a.bass_deg);
-          j["top_deg"] = to_optional_array(a.top_deg);
-          j["expect_root"] = to_bool_array(a.expect_root);
-          j["expect_bass"] = to_bool_array(a.expect_bass);
-          j["expect_top"] = to_bool_array(a.expect_top);
-        } else if constexpr (std::is_same_v<T, MelodyAnswerV2>) {
-          j["type"] = "melody";
-          nlohmann::json arr = nlohmann::json::array();
-          for (int v : a.melody) { arr.push_back(v); }
-          j["melody"] = std::move(arr);
-        } else if constexpr (std::is_same_v<T, HarmonyAnswerV2>) {
-          j["type"] = "harmony";
-          nlohmann::json arr = nlohmann::json::array();
-          for (int v : a.notes) { arr.push_back(v); }
-          j["notes"] = std::move(arr);
-        }
-        return j;
-      },
-      payload);
+  // Index switch in place of std::visit: no dispatch table, and each
+  // alternative serializes through a plainly named free function.
+  switch (payload.index()) {
+    case 0: return chord_answer_to_json(std::get<0>(payload));
+    case 1: return melody_answer_to_json(std::get<1>(payload));
+    default: return harmony_answer_to_json(std::get<2>(payload));
+  }
 }
 
 static std::string triad_quality_to_string(TriadQuality quality) {
-  switch (quality) {
-    case TriadQuality::Major:
-      return "major";
-    case TriadQuality::Minor:
-      return "minor";
-    case TriadQuality::Diminished:
-      return "diminished";
-  }
-  return "major";
+  // Forward to the canonical name table in chord_voicings.
+  return std::string(ear::to_string(quality));
 }
 
-static TriadQuality triad_quality_from_string(const std::string& quality) {
-  if (quality == "minor") {
-    return TriadQuality::Minor;
+static TriadQuality triad_quality_from_string(std::string_view quality) {
+  // The accepted names have distinct lengths, so the length selects the one
+  // candidate and a single comparison confirms it (builtin_creator keying).
+  switch (quality.size()) {
+    case 5:  return quality == "minor" ? TriadQuality::Minor : TriadQuality::Major;
+    case 3:  return quality == "dim" ? TriadQuality::Diminished : TriadQuality::Major;
+    case 10: return quality == "diminished" ? TriadQuality::Diminished : TriadQuality::Major;
+    default: return TriadQuality::Major;
   }
-  if (quality == "diminished" || quality == "dim") {
-    return TriadQuality::Diminished;
-  }
-  return TriadQuality::Major;
 }
 
-static KeyQuality key_quality_from_string(const std::string& quality) {
+static KeyQuality key_quality_from_string(std::string_view quality) {
   if (quality == "minor") {
     return KeyQuality::Minor;
   }
   return KeyQuality::Major;
 }
 
+static nlohmann::json chord_question_to_json(const ChordQuestionV2& q) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "chord";
+  j["tonic_midi"] = q.tonic_midi;
+  j["tonic"] = q.tonic;
+  j["key"] = key_quality_to_string(q.key);
+  auto to_int_array = [](const std::vector<int>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (int v : values) { arr.push_back(v); }
+    return arr;
+  };
+  auto to_quality_array = [](const std::vector<TriadQuality>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (auto qv : values) { arr.push_back(triad_quality_to_string(qv)); }
+    return arr;
+  };
+  auto to_optional_vec_array = [](const std::vector<std::optional<std::vector<int>>>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (const auto& opt : values) {
+      if (!opt.has_value()) {
+        arr.push_back(nullptr);
+      } else {
+        nlohmann::json inner = nlohmann::json::array();
+        for (int v : opt.value()) { inner.push_back(v); }
+        arr.push_back(std::move(inner));
+      }
+    }
+    return arr;
+  };
+  auto to_optional_array = [](const auto& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (const auto& opt : values) {
+      if (opt.has_value()) {
+        arr.push_back(opt.value());
+      } else {
+        arr.push_back(nullptr);
+      }
+    }
+    return arr;
+  };
+  auto to_bool_array = [](const std::vector<bool>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(values.size());
+    for (bool v : values) { arr.push_back(v); }
+    return arr;
+  };
+
+  j["root_degrees"] = to_int_array(q.root_degrees);
+  j["qualities"] = to_quality_array(q.qualities);
+  j["rh_degrees"] = to_optional_vec_array(q.rh_degrees);
+  j["bass_degrees"] = to_optional_array(q.bass_degrees);
+  j["right_voicing_id"] = to_optional_array(q.right_voicing_ids);
+  j["bass_voicing_id"] = to_optional_array(q.bass_voicing_ids);
+  j["is_anchor"] = to_bool_array(q.is_anchor);
+
+  // legacy single-chord mirror for older clients
+  if (!q.root_degrees.empty()) {
+    j["root_degree"] = q.root_degrees.front();
+  }
+  if (!q.qualities.empty()) {
+    j["quality"] = triad_quality_to_string(q.qualities.front());
+  }
+  return j;
+}
+
+static nlohmann::json melody_question_to_json(const MelodyQuestionV2& q) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "melody";
+  j["tonic_midi"] = q.tonic_midi;
+  j["tonic"] = q.tonic;
+  j["key"] = key_quality_to_string(q.key);
+  nlohmann::json melody = nlohmann::json::array();
+  melody.reserve(q.melody.size());
+  for (int value : q.melody) {
+    melody.push_back(value);
+  }
+  j["melody"] = std::move(melody);
+  if (q.octave.has_value()) {
+    nlohmann::json arr = nlohmann::json::array();
+    arr.reserve(q.octave.value().size());
+    for (int value : q.octave.value()) {
+      arr.push_back(value);
+    }
+    j["octave"] = std::move(arr);
+  } else {
+    j["octave"] = nullptr;
+  }
+  j["helper"] = q.helper.has_value() ? nlohmann::json(q.helper.value()) : nlohmann::json(nullptr);
+  return j;
+}
+
+static nlohmann::json harmony_question_to_json(const HarmonyQuestionV2& q) {
+  nlohmann::json j = nlohmann::json::object();
+  j["type"] = "harmony";
+  j["tonic_midi"] = q.tonic_midi;
+  j["tonic"] = q.tonic;
+  j["key"] = key_quality_to_string(q.key);
+  j["note_num"] = q.note_num;
+  nlohmann::json notes = nlohmann::json::array();
+  notes.reserve(q.notes.size());
+  for (int value : q.notes) {
+    notes.push_back(value);
+  }
+  j["notes"] = std::move(notes);
+  j["interval"] = q.interval.has_value() ? nlohmann::json(q.interval.value()) : nlohmann::json(nullptr);
+  return j;
+}
+
 static nlohmann::json question_payload_v2_to_json(const QuestionPayloadV2& payload) {
-  return std::visit(
-      [](const auto& q) -> nlohmann::json {
-        using T = std::decay_t<decltype(q)>;
-        nlohmann::json j = nlohmann::json::object();
-        if constexpr (std::is_same_v<T, ChordQuestionV2>) {
-          j["type"] = "chord";
-          j["tonic_midi"] = q.tonic_midi;
-          j["tonic"] = q.tonic;
-          j["key"] = key_quality_to_string(q.key);
-          auto to_int_array = [](const std::vector<int>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int v : values) { arr.push_back(v); }
-            return arr;
-          };
-          auto to_quality_array = [](const std::vector<TriadQuality>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (auto qv : values) { arr.push_back(triad_quality_to_string(qv)); }
-            return arr;
-          };
-          auto to_optional_vec_array = [](const std::vector<std::optional<std::vector<int>>>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& opt : values) {
-              if (!opt.has_value()) {
-                arr.push_back(nullptr);
-              } else {
-                nlohmann::json inner = nlohmann::json::array();
-                for (int v : opt.value()) { inner.push_back(v); }
-                arr.push_back(std::move(inner));
-              }
-            }
-            return arr;
-          };
-          auto to_optional_array = [](const auto& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& opt : values) {
-              if (opt.has_value()) {
-                arr.push_back(opt.value());
-              } else {
-                arr.push_back(nullptr);
-              }
-            }
-            return arr;
-          };
-          auto to_bool_array = [](const std::vector<bool>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (bool v : values) { arr.push_back(v); }
-            return arr;
-          };
-
-          j["root_degrees"] = to_int_array(q.root_degrees);
-          j["qualities"] = to_quality_array(q.qualities);
-          j["rh_degrees"] = to_optional_vec_array(q.rh_degrees);
-          j["bass_degrees"] = to_optional_array(q.bass_degrees);
-          j["right_voicing_id"] = to_optional_array(q.right_voicing_ids);
-          j["bass_voicing_id"] = to_optional_array(q.bass_voicing_ids);
-          j["is_anchor"] = to_bool_array(q.is_anchor);
-
-          // legacy single-chord mirror for older clients
-          if (!q.root_degrees.empty()) {
-            j["root_degree"] = q.root_degrees.front();
-          }
-          if (!q.qualities.empty()) {
-            j["quality"] = triad_quality_to_string(q.qualities.front());
-          }
-        } else if constexpr (std::is_same_v<T, MelodyQuestionV2>) {
-          j["type"] = "melody";
-          j["tonic_midi"] = q.tonic_midi;
-          j["tonic"] = q.tonic;
-          j["key"] = key_quality_to_string(q.key);
-          nlohmann::json melody = nlohmann::json::array();
-          for (int value : q.melody) {
-            melody.push_back(value);
-          }
-          j["melody"] = std::move(melody);
-          if (q.octave.has_value()) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int value : q.octave.value()) {
-              arr.push_back(value);
-            }
-            j["octave"] = std::move(arr);
-          } else {
-            j["octave"] = nullptr;
-          }
-          j["helper"] = q.helper.has_value() ? nlohmann::json(q.helper.value()) : nlohmann::json(nullptr);
-        } else if constexpr (std::is_same_v<T, HarmonyQuestionV2>) {
-          j["type"] = "harmony";
-          j["tonic_midi"] = q.tonic_midi;
-          j["tonic"] = q.tonic;
-          j["key"] = key_quality_to_string(q.key);
-          j["note_num"] = q.note_num;
-          nlohmann::json notes = nlohmann::json::array();
-          for (int value : q.notes) {
-            notes.push_back(value);
-          }
-          j["notes"] = std::move(notes);
-          j["interval"] = q.interval.has_value() ? nlohmann::json(q.interval.value()) : nlohmann::json(nullptr);
-        }
-        return j;
-      },
-      payload);
+  // Index switch instead of std::visit, matching the answer-side encoder.
+  switch (payload.index()) {
+    case 0: return chord_question_to_json(std::get<0>(payload));
+    case 1: return melody_question_to_json(std::get<1>(payload));
+    default: return harmony_question_to_json(std::get<2>(payload));
+  }
 }
 
-static QuestionPayloadV2 question_payload_v2_from_json(const nlohmann::json& json) {
-  const std::string type = json.contains("type") && json["type"].is_string() ? json["type"].get<std::string>() : std::string();
-  if (type == "chord") {
-    ChordQuestionV2 q{};
-    q.tonic_midi = json.contains("tonic_midi") ? json["tonic_midi"].get<int>() : 0;
-    q.tonic = json.contains("tonic") && json["tonic"].is_string() ? json["tonic"].get<std::string>() : std::string();
-    q.key = json.contains("key") && json["key"].is_string() ? key_quality_from_string(json["key"].get<std::string>())
-                                                              : KeyQuality::Major;
-    auto parse_int_array = [&](const char* key) {
-      std::vector<int> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].get<int>());
-        }
+// Shared question header (tonic_midi / tonic / key): one find_member walk
+// per field instead of the contains + operator[] + get triple lookup.
+template <typename Question>
+static void parse_question_header(Question& q, const nlohmann::json& json) {
+  if (const auto* tonic_midi = json.find_member("tonic_midi")) {
+    q.tonic_midi = tonic_midi->get<int>();
+  }
+  if (const auto* tonic = json.find_member("tonic"); tonic && tonic->is_string()) {
+    q.tonic = tonic->get_string();
+  }
+  if (const auto* key = json.find_member("key"); key && key->is_string()) {
+    q.key = key_quality_from_string(key->get_string());
+  }
+}
+
+static ChordQuestionV2 chord_question_from_json(const nlohmann::json& json) {
+  ChordQuestionV2 q{};
+  parse_question_header(q, json);
+  auto parse_int_array = [&](const char* key) {
+    std::vector<int> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        values.push_back(item.get<int>());
       }
-      return values;
-    };
-    auto parse_quality_array = [&]() {
-      std::vector<TriadQuality> values;
-      if (json.contains("qualities") && json["qualities"].is_array()) {
-        const auto& arr = json["qualities"];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(triad_quality_from_string(arr[i].get<std::string>()));
-        }
+    }
+    return values;
+  };
+  auto parse_quality_array = [&]() {
+    std::vector<TriadQuality> values;
+    if (const auto* arr = json.find_member("qualities"); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        values.push_back(triad_quality_from_string(item.get_string()));
       }
-      return values;
-    };
-    auto parse_optional_vec_array = [&](const char* key) {
-      std::vector<std::optional<std::vector<int>>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          if (arr[i].is_null()) {
-            values.push_back(std::nullopt);
-          } else if (arr[i].is_array()) {
-            std::vector<int> inner;
-            inner.reserve(arr[i].size());
-            for (std::size_t j = 0; j < arr[i].size(); ++j) {
-              inner.push_back(arr[i][j].get<int>());
-            }
-            values.push_back(std::move(inner));
-          } else {
-            values.push_back(std::nullopt);
+    }
+    return values;
+  };
+  auto parse_optional_vec_array = [&](const char* key) {
+    std::vector<std::optional<std::vector<int>>> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        if (item.is_array()) {
+          const auto& inner_items = item.get_array();
+          std::vector<int> inner;
+          inner.reserve(inner_items.size());
+          for (const auto& inner_item : inner_items) {
+            inner.push_back(inner_item.get<int>());
           }
+          values.push_back(std::move(inner));
+        } else {
+          values.push_back(std::nullopt);
         }
       }
-      return values;
-    };
-    auto parse_optional_array = [&](const char* key) {
-      std::vector<std::optional<int>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].is_null() ? std::optional<int>() : std::optional<int>(arr[i].get<int>()));
-        }
-      }
-      return values;
-    };
-    auto parse_optional_string_array = [&](const char* key) {
-      std::vector<std::optional<std::string>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].is_null() ? std::optional<std::string>()
-                                            : std::optional<std::string>(arr[i].get<std::string>()));
-        }
+    }
+    return values;
+  };
+  auto parse_optional_array = [&](const char* key) {
+    std::vector<std::optional<int>> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        values.push_back(item.is_null() ? std::optional<int>() : std::optional<int>(item.get<int>()));
       }
-      return values;
-    };
-    auto parse_bool_array = [&](const char* key) {
-      std::vector<bool> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].get<bool>());
+    }
+    return values;
+  };
+  auto parse_optional_string_array = [&](const char* key) {
+    std::vector<std::optional<std::string>> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        if (item.is_null()) {
+          values.emplace_back();
+        } else {
+          // Construct the owned copy straight from the stored string; no
+          // intermediate temporary from get<std::string>().
+          values.emplace_back(std::in_place, item.get_string());
         }
       }
-      return values;
-    };
-
-    q.root_degrees = parse_int_array("root_degrees");
-    if (q.root_degrees.empty()) {
-      q.root_degrees.push_back(json.contains("root_degree") ? json["root_degree"].get<int>() : 0);
     }
-    q.qualities = parse_quality_array();
-    if (q.qualities.empty()) {
-      q.qualities.push_back(json.contains("quality") && json["quality"].is_string()
-                                ? triad_quality_from_string(json["quality"].get<std::string>())
-                                : TriadQuality::Major);
-    }
-    std::size_t len = q.root_degrees.size();
-    auto ensure_size = [&](auto&& vec, auto default_value) {
-      using Vec = std::decay_t<decltype(vec)>;
-      Vec out = std::forward<decltype(vec)>(vec);
-      if (out.size() < len) {
-        out.resize(len, default_value);
-      }
-      return out;
-    };
-    q.rh_degrees = ensure_size(parse_optional_vec_array("rh_degrees"), std::optional<std::vector<int>>{});
-    q.bass_degrees = ensure_size(parse_optional_array("bass_degrees"), std::optional<int>{});
-    q.right_voicing_ids = ensure_size(parse_optional_string_array("right_voicing_id"), std::optional<std::string>{});
-    q.bass_voicing_ids = ensure_size(parse_optional_string_array("bass_voicing_id"), std::optional<std::string>{});
-    q.is_anchor = ensure_size(parse_bool_array("is_anchor"), false);
-    return q;
-  }
-  if (type == "melody") {
-    MelodyQuestionV2 q{};
-    q.tonic_midi = json.contains("tonic_midi") ? json["tonic_midi"].get<int>() : 0;
-    q.tonic = json.contains("tonic") && json["tonic"].is_string() ? json["tonic"].get<std::string>() : std::string();
-    q.key = json.contains("key") && json["key"].is_string() ? key_quality_from_string(json["key"].get<std::string>())
-                                                              : KeyQuality::Major;
-    q.melody.clear();
-    if (json.contains("melody") && json["melody"].is_array()) {
-      const auto& arr = json["melody"];
-      q.melody.reserve(arr.size());
-      for (std::size_t i = 0; i < arr.size(); ++i) {
-        q.melody.push_back(arr[i].get<int>());
+    return values;
+  };
+  auto parse_bool_array = [&](const char* key) {
+    std::vector<bool> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        values.push_back(item.get<bool>());
       }
     }
-    if (json.contains("octave") && json["octave"].is_array()) {
-      const auto& arr = json["octave"];
-      std::vector<int> values;
-      values.reserve(arr.size());
-      for (std::size_t i = 0; i < arr.size(); ++i) {
-        values.push_back(arr[i].get<int>());
-      }
-      q.octave = std::move(values);
+    return values;
+  };
+
+  q.root_degrees = parse_int_array("root_degrees");
+  if (q.root_degrees.empty()) {
+    const auto* root = json.find_member("root_degree");
+    q.root_degrees.push_back(root ? root->get<int>() : 0);
+  }
+  q.qualities = parse_quality_array();
+  if (q.qualities.empty()) {
+    const auto* quality = json.find_member("quality");
+    q.qualities.push_back(quality && quality->is_string()
+                              ? triad_quality_from_string(quality->get_string())
+                              : TriadQuality::Major);
+  }
+  std::size_t len = q.root_degrees.size();
+  // By-value parameter: the parse results move in, resize happens in
+  // place, and the named return moves straight into the member.
+  auto ensure_size = [&](auto vec, auto default_value) {
+    if (vec.size() < len) {
+      vec.resize(len, default_value);
     }
-    if (json.contains("helper") && !json["helper"].is_null()) {
-      q.helper = json["helper"].get<std::string>();
+    return vec;
+  };
+  q.rh_degrees = ensure_size(parse_optional_vec_array("rh_degrees"), std::optional<std::vector<int>>{});
+  q.bass_degrees = ensure_size(parse_optional_array("bass_degrees"), std::optional<int>{});
+  q.right_voicing_ids = ensure_size(parse_optional_string_array("right_voicing_id"), std::optional<std::string>{});
+  q.bass_voicing_ids = ensure_size(parse_optional_string_array("bass_voicing_id"), std::optional<std::string>{});
+  q.is_anchor = ensure_size(parse_bool_array("is_anchor"), false);
+  return q;
+}
+
+static MelodyQuestionV2 melody_question_from_json(const nlohmann::json& json) {
+  MelodyQuestionV2 q{};
+  parse_question_header(q, json);
+  if (const auto* arr = json.find_member("melody"); arr && arr->is_array()) {
+    const auto& items = arr->get_array();
+    q.melody.reserve(items.size());
+    for (const auto& item : items) {
+      q.melody.push_back(item.get<int>());
     }
-    return q;
-  }
-  if (type == "harmony") {
-    HarmonyQuestionV2 q{};
-    q.tonic_midi = json.contains("tonic_midi") ? json["tonic_midi"].get<int>() : 0;
-    q.tonic = json.contains("tonic") && json["tonic"].is_string() ? json["tonic"].get<std::string>() : std::string();
-    q.key = json.contains("key") && json["key"].is_string() ? key_quality_from_string(json["key"].get<std::string>())
-                                                              : KeyQuality::Major;
-    q.note_num = json.contains("note_num") ? json["note_num"].get<int>() : 0;
-    q.notes.clear();
-    if (json.contains("notes") && json["notes"].is_array()) {
-      const auto& arr = json["notes"];
-      q.notes.reserve(arr.size());
-      for (std::size_t i = 0; i < arr.size(); ++i) {
-        q.notes.push_back(arr[i].get<int>());
-      }
+  }
+  if (const auto* arr = json.find_member("octave"); arr && arr->is_array()) {
+    std::vector<int> values;
+    const auto& items = arr->get_array();
+    values.reserve(items.size());
+    for (const auto& item : items) {
+      values.push_back(item.get<int>());
     }
-    if (json.contains("interval") && !json["interval"].is_null()) {
-      q.interval = json["interval"].get<std::string>();
+    q.octave = std::move(values);
+  }
+  if (const auto* helper = json.find_member("helper"); helper && !helper->is_null()) {
+    q.helper = helper->get<std::string>();
+  }
+  return q;
+}
+
+static HarmonyQuestionV2 harmony_question_from_json(const nlohmann::json& json) {
+  HarmonyQuestionV2 q{};
+  parse_question_header(q, json);
+  if (const auto* note_num = json.find_member("note_num")) {
+    q.note_num = note_num->get<int>();
+  }
+  if (const auto* arr = json.find_member("notes"); arr && arr->is_array()) {
+    const auto& items = arr->get_array();
+    q.notes.reserve(items.size());
+    for (const auto& item : items) {
+      q.notes.push_back(item.get<int>());
     }
-    return q;
   }
-  throw std::runtime_error("Unknown QuestionPayloadV2 type: " + type);
+  if (const auto* interval = json.find_member("interval"); interval && !interval->is_null()) {
+    q.interval = interval->get<std::string>();
+  }
+  return q;
 }
 
-static AnswerPayloadV2 answer_payload_v2_from_json(const nlohmann::json& json) {
-  const std::string type = json["type"].get<std::string>();
-  if (type == "chord") {
-    ChordAnswerV2 a{};
-    auto parse_int_array = [&](const char* key) {
-      std::vector<int> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].get<int>());
-        }
-      }
-      return values;
-    };
-    auto parse_optional_array = [&](const char* key, std::size_t target) {
-      std::vector<std::optional<int>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].is_null() ? std::optional<int>() : std::optional<int>(arr[i].get<int>()));
-        }
-      }
-      if (!values.empty() && values.size() != target) {
-        values.resize(target);
+// Cold, out-of-line throw so the dispatchers can keep the tag as a
+// borrowed string_view with no exception-preparation code inline.
+[[noreturn]] static void throw_unknown_payload_type(const char* which, std::string_view type) {
+  throw std::runtime_error(std::string("Unknown ").append(which).append(" type: ").append(type));
+}
+
+static QuestionPayloadV2 question_payload_v2_from_json(const nlohmann::json& json) {
+  const auto* type_member = json.find_member("type");
+  const std::string_view type = type_member && type_member->is_string()
+                                    ? std::string_view(type_member->get_string())
+                                    : std::string_view();
+  // Type tags have distinct lengths; length picks the candidate, one
+  // comparison confirms, and each parse path lives in its own function.
+  switch (type.size()) {
+    case 5: if (type == "chord") return chord_question_from_json(json); break;
+    case 6: if (type == "melody") return melody_question_from_json(json); break;
+    case 7: if (type == "harmony") return harmony_question_from_json(json); break;
+    default: break;
+  }
+  throw_unknown_payload_type("QuestionPayloadV2", type);
+}
+
+static ChordAnswerV2 chord_answer_from_json(const nlohmann::json& json) {
+  ChordAnswerV2 a{};
+  auto parse_int_array = [&](const char* key) {
+    std::vector<int> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(items.size());
+      for (const auto& item : items) {
+        values.push_back(item.get<int>());
       }
-      return values;
-    };
-    auto parse_bool_array = [&](const char* key, std::size_t target) {
-      std::vector<bool> values;
-      if (json.contains(key) && json[key].is_array()) {
-        const auto& arr = json[key];
-        values.reserve(arr.size());
-        for (std::size_t i = 0; i < arr.size(); ++i) {
-          values.push_back(arr[i].get<bool>());
-        }
+    }
+    return values;
+  };
+  auto parse_optional_array = [&](const char* key, std::size_t target) {
+    std::vector<std::optional<int>> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      // One reservation covers both the parsed elements and the padding
+      // resize below, so the column never reallocates.
+      values.reserve(std::max(items.size(), target));
+      for (const auto& item : items) {
+        values.push_back(item.is_null() ? std::optional<int>() : std::optional<int>(item.get<int>()));
       }
-      if (!values.empty() && values.size() != target) {
-        values.resize(target, true);
+    }
+    if (!values.empty() && values.size() != target) {
+      values.resize(target);
+    }
+    return values;
+  };
+  auto parse_bool_array = [&](const char* key, std::size_t target) {
+    std::vector<bool> values;
+    if (const auto* arr = json.find_member(key); arr && arr->is_array()) {
+      const auto& items = arr->get_array();
+      values.reserve(std::max(items.size(), target));
+      for (const auto& item : items) {
+        values.push_back(item.get<bool>());
       }
-      return values;
-    };
+    }
+    if (!values.empty() && values.size() != target) {
+      values.resize(target, true);
+    }
+    return values;
+  };
 
-    if (json.contains("root_degrees")) {
-      a.root_degrees = parse_int_array("root_degrees");
-    } else {
-      int single_root = json.contains("root_degree") ? json["root_degree"].get<int>() : 0;
-      a.root_degrees.push_back(single_root);
+  if (json.contains("root_degrees")) {
+    a.root_degrees = parse_int_array("root_degrees");
+  } else {
+    const auto* root = json.find_member("root_degree");
+    a.root_degrees.push_back(root ? root->get<int>() : 0);
+  }
+  std::size_t len = a.root_degrees.size();
+  if (len == 0) {
+    a.root_degrees.push_back(0);
+    len = 1;
+  }
+  auto opt_or_default = [&](std::vector<std::optional<int>> values) {
+    if (values.empty()) {
+      values.resize(len);
     }
-    std::size_t len = a.root_degrees.size();
-    if (len == 0) {
-      a.root_degrees.push_back(0);
-      len = 1;
+    return values;
+  };
+  a.bass_deg = opt_or_default(parse_optional_array("bass_deg", len));
+  a.top_deg = opt_or_default(parse_optional_array("top_deg", len));
+  auto ensure_bool = [&](std::vector<bool> values) {
+    if (values.empty()) {
+      values.resize(len, true);
     }
-    auto opt_or_default = [&](std::vector<std::optional<int>> values) {
-      if (values.empty()) {
-        values.resize(len);
-      }
-      return values;
-    };
-    a.bass_deg = opt_or_default(parse_optional_array("bass_deg", len));
-    a.top_deg = opt_or_default(parse_optional_array("top_deg", len));
-    auto ensure_bool = [&](std::vector<bool> values) {
-      if (values.empty()) {
-        values.resize(len, true);
-      }
-      return values;
-    };
-    a.expect_root = ensure_bool(parse_bool_array("expect_root", len));
-    a.expect_bass = ensure_bool(parse_bool_array("expect_bass", len));
-    a.expect_top = ensure_bool(parse_bool_array("expect_top", len));
-    return a;
-  }
-  if (type == "melody") {
-    MelodyAnswerV2 a{};
-    a.melody.clear();
-    if (json.contains("melody") && json["melody"].is_array()) {
-      const auto& arr = json["melody"];
-      a.melody.reserve(arr.size());
-      for (std::size_t i = 0; i < arr.size(); ++i) {
-        a.melody.push_back(arr[i].get<int>());
-      }
+    return values;
+  };
+  a.expect_root = ensure_bool(parse_bool_array("expect_root", len));
+  a.expect_bass = ensure_bool(parse_bool_array("expect_bass", len));
+  a.expect_top = ensure_bool(parse_bool_array("expect_top", len));
+  return a;
+}
+
+static MelodyAnswerV2 melody_answer_from_json(const nlohmann::json& json) {
+  MelodyAnswerV2 a{};
+  if (const auto* arr = json.find_member("melody"); arr && arr->is_array()) {
+    const auto& items = arr->get_array();
+    a.melody.reserve(items.size());
+    for (const auto& item : items) {
+      a.melody.push_back(item.get<int>());
     }
-    return a;
-  }
-  if (type == "harmony") {
-    HarmonyAnswerV2 a{};
-    a.notes.clear();
-    if (json.contains("notes") && json["notes"].is_array()) {
-      const auto& arr = json["notes"];
-      a.notes.reserve(arr.size());
-      for (std::size_t i = 0; i < arr.size(); ++i) {
-        a.notes.push_back(arr[i].get<int>());
-      }
+  }
+  return a;
+}
+
+static HarmonyAnswerV2 harmony_answer_from_json(const nlohmann::json& json) {
+  HarmonyAnswerV2 a{};
+  if (const auto* arr = json.find_member("notes"); arr && arr->is_array()) {
+    const auto& items = arr->get_array();
+    a.notes.reserve(items.size());
+    for (const auto& item : items) {
+      a.notes.push_back(item.get<int>());
     }
-    return a;
   }
-  throw std::runtime_error("Unknown AnswerPayloadV2 type: " + type);
+  return a;
+}
+
+static AnswerPayloadV2 answer_payload_v2_from_json(const nlohmann::json& json) {
+  const std::string_view type = json["type"].get_string();
+  switch (type.size()) {
+    case 5: if (type == "chord") return chord_answer_from_json(json); break;
+    case 6: if (type == "melody") return melody_answer_from_json(json); break;
+    case 7: if (type == "harmony") return harmony_answer_from_json(json); break;
+    default: break;
+  }
+  throw_unknown_payload_type("AnswerPayloadV2", type);
 }
 
 } // namespace
@@ -1162,16 +1266,18 @@ nlohmann::json to_json(const SessionSpec& spec) {
   json_spec["generation"] = spec.generation;
 
   nlohmann::json assistance = nlohmann::json::object();
-  for (const auto& entry : spec.assistance_policy) {
-    assistance[entry.first] = entry.second;
+  {
+    // Emplace directly on the map: operator[] would default-construct a node
+    // and assign over it on every entry. The policy round-trips through the
+    // parser in key order, so the end() hint keeps each insert O(1).
+    auto& obj = assistance.get_object();
+    for (const auto& entry : spec.assistance_policy) {
+      obj.emplace_hint(obj.end(), entry.first, entry.second);
+    }
   }
-  json_spec["assistance_policy"] = assistance;
+  json_spec["assistance_policy"] = std::move(assistance);
   json_spec["sampler_params"] = spec.sampler_params;
-  nlohmann::json track_levels = nlohmann::json::array();
-  for (int level : spec.track_levels) {
-    track_levels.push_back(level);
-  }
-  json_spec["track_levels"] = track_levels;
+  json_spec["track_levels"] = ints_to_json_array(spec.track_levels);
   json_spec["seed"] = static_cast<std::int64_t>(spec.seed);
   json_spec["adaptive"] = spec.adaptive;
   json_spec["mode"] = to_string(spec.mode);
@@ -1195,7 +1301,10 @@ nlohmann::json to_json(const SessionSpec& spec) {
   return json_spec;
 }
 
-SessionSpec session_spec_from_json(const nlohmann::json& json_spec) {
+// `owned` is non-null when the caller handed over the spec by rvalue, in
+// which case the sampler_params subtree is stolen instead of deep-copied.
+static SessionSpec session_spec_from_json_impl(const nlohmann::json& json_spec,
+                                               nlohmann::json* owned) {
   SessionSpec spec;
   spec.version = json_spec["version"].get<std::string>();
   spec.drill_kind = json_spec["drill_kind"].get<std::string>();
@@ -1207,24 +1316,35 @@ SessionSpec session_spec_from_json(const nlohmann::json& json_spec) {
   spec.generation = json_spec["generation"].get<std::string>();
   spec.assistance_policy.clear();
   const auto& assistance = json_spec["assistance_policy"].get_object();
+  spec.assistance_policy.reserve(assistance.size());
   for (const auto& entry : assistance) {
-    spec.assistance_policy[entry.first] = entry.second.get<int>();
-  }
-  spec.sampler_params =
-      json_spec.contains("sampler_params") ? json_spec["sampler_params"] : nlohmann::json::object();
-  if (!spec.sampler_params.is_object()) {
+    spec.assistance_policy.emplace_back(entry.first, entry.second.get<int>());
+  }
+  // Optional keys below resolve through find_member: one map walk per key
+  // instead of the contains()+operator[] pair (and often a third lookup for
+  // the type check) this function used to do.
+  const auto* sampler_params = json_spec.find_member("sampler_params");
+  if (sampler_params && sampler_params->is_object()) {
+    if (owned) {
+      auto it = owned->get_object().find("sampler_params");
+      spec.sampler_params = std::move(it->second);
+    } else {
+      spec.sampler_params = *sampler_params;
+    }
+  } else {
     spec.sampler_params = nlohmann::json::object();
   }
 
-  if (json_spec.contains("range") && json_spec["range"].is_array()) {
-    const auto& range = json_spec["range"];
+  if (const auto* range_node = json_spec.find_member("range");
+      range_node && range_node->is_array()) {
+    const auto& range = *range_node;
     if (range.size() == 2) {
       const auto to_int = [](const nlohmann::json& node, int fallback) -> int {
         if (node.is_number_integer()) {
-          return node.get<int>();
+          return static_cast<int>(node.get_integer_unchecked());
         }
         if (node.is_number_float()) {
-          return static_cast<int>(std::lround(node.get<double>()));
+          return static_cast<int>(std::lround(node.get_float_unchecked()));
         }
         return fallback;
       };
@@ -1246,37 +1366,38 @@ SessionSpec session_spec_from_json(const nlohmann::json& json_spec) {
     }
   }
 
-  if (json_spec.contains("track_levels")) {
-    const auto& levels = json_spec["track_levels"];
-    if (levels.is_array()) {
-      spec.track_levels.clear();
-      for (const auto& entry : levels.get_array()) {
-        if (entry.is_number_integer()) {
-          spec.track_levels.push_back(entry.get<int>());
-        }
+  if (const auto* levels = json_spec.find_member("track_levels");
+      levels && levels->is_array()) {
+    const auto& entries = levels->get_array();
+    spec.track_levels.clear();
+    spec.track_levels.reserve(entries.size());
+    for (const auto& entry : entries) {
+      if (entry.is_number_integer()) {
+        spec.track_levels.push_back(static_cast<int>(entry.get_integer_unchecked()));
       }
     }
   }
   spec.seed = static_cast<std::uint64_t>(json_spec["seed"].get<long long>());
-  if (json_spec.contains("adaptive")) {
-    spec.adaptive = json_spec["adaptive"].get<bool>();
-  }
-  if (json_spec.contains("mode") && json_spec["mode"].is_string()) {
-    try {
-      spec.mode = session_mode_from_string(json_spec["mode"].get<std::string>());
-    } catch (const std::exception&) {
-      spec.mode = spec.adaptive ? SessionMode::Adaptive : SessionMode::Manual;
-    }
-  } else if (json_spec.contains("level_inspect") && json_spec["level_inspect"].is_boolean() &&
-             json_spec["level_inspect"].get<bool>()) {
+  if (const auto* adaptive = json_spec.find_member("adaptive")) {
+    spec.adaptive = adaptive->get<bool>();
+  }
+  const auto* level_inspect = json_spec.find_member("level_inspect");
+  if (const auto* mode_node = json_spec.find_member("mode");
+      mode_node && mode_node->is_string()) {
+    const auto mode = try_session_mode_from_string(mode_node->get<std::string>());
+    spec.mode = mode.has_value()
+                    ? *mode
+                    : (spec.adaptive ? SessionMode::Adaptive : SessionMode::Manual);
+  } else if (level_inspect && level_inspect->is_boolean() &&
+             level_inspect->get_boolean_unchecked()) {
     spec.mode = SessionMode::LevelInspector;
   } else if (spec.adaptive) {
     spec.mode = SessionMode::Adaptive;
   } else {
     spec.mode = SessionMode::Manual;
   }
-  if (json_spec.contains("level_inspect")) {
-    spec.level_inspect = json_spec["level_inspect"].get<bool>();
+  if (level_inspect) {
+    spec.level_inspect = level_inspect->get<bool>();
     if (spec.level_inspect) {
       spec.mode = SessionMode::LevelInspector;
     }
@@ -1284,23 +1405,35 @@ SessionSpec session_spec_from_json(const nlohmann::json& json_spec) {
     spec.level_inspect = (spec.mode == SessionMode::LevelInspector);
   }
   spec.adaptive = (spec.mode == SessionMode::Adaptive);
-  if (json_spec.contains("inspect_level") && !json_spec["inspect_level"].is_null()) {
-    spec.inspect_level = json_spec["inspect_level"].get<int>();
+  if (const auto* inspect_level = json_spec.find_member("inspect_level");
+      inspect_level && !inspect_level->is_null()) {
+    spec.inspect_level = inspect_level->get<int>();
   }
-  if (json_spec.contains("inspect_tier") && !json_spec["inspect_tier"].is_null()) {
-    spec.inspect_tier = json_spec["inspect_tier"].get<int>();
+  if (const auto* inspect_tier = json_spec.find_member("inspect_tier");
+      inspect_tier && !inspect_tier->is_null()) {
+    spec.inspect_tier = inspect_tier->get<int>();
   }
-  if (json_spec.contains("lesson") && !json_spec["lesson"].is_null()) {
-    spec.lesson = json_spec["lesson"].get<int>();
+  if (const auto* lesson = json_spec.find_member("lesson");
+      lesson && !lesson->is_null()) {
+    spec.lesson = lesson->get<int>();
   }
-  if (json_spec.contains("params") && json_spec["params"].is_object()) {
-    spec.params = params_from_json(spec.drill_kind, json_spec["params"]);
+  if (const auto* params = json_spec.find_member("params");
+      params && params->is_object()) {
+    spec.params = params_from_json(spec.drill_kind, *params);
   } else {
     spec.params = DrillParams{};
   }
   return spec;
 }
 
+SessionSpec session_spec_from_json(const nlohmann::json& json_spec) {
+  return session_spec_from_json_impl(json_spec, nullptr);
+}
+
+SessionSpec session_spec_from_json(nlohmann::json&& json_spec) {
+  return session_spec_from_json_impl(json_spec, &json_spec);
+}
+
 nlohmann::json to_json(const QuestionBundle& bundle) {
   nlohmann::json json_bundle = nlohmann::json::object();
   json_bundle["question_id"] = bundle.question_id;
@@ -1314,6 +1447,7 @@ nlohmann::json to_json(const QuestionBundle& bundle) {
   if (bundle.ui_hints.has_value()) {
     nlohmann::json hints = nlohmann::json::object();
     nlohmann::json assists = nlohmann::json::array();
+    assists.reserve(bundle.ui_hints->allowed_assists.size());
     for (const auto& s : bundle.ui_hints->allowed_assists) { assists.push_back(s); }
     hints["allowed_assists"] = std::move(assists);
     json_bundle["ui_hints"] = std::move(hints);
@@ -1366,21 +1500,26 @@ nlohmann::json to_json(const ResultReport& report) {
   json_report["final_answer"] = answer_payload_v2_to_json(report.final_answer);
   json_report["correct"] = report.correct;
   nlohmann::json metrics = nlohmann::json::object();
-  metrics["rt_ms"] = report.metrics.rt_ms;
-  metrics["attempts"] = report.metrics.attempts;
-  metrics["question_count"] = report.metrics.question_count;
-  nlohmann::json assists = nlohmann::json::object();
-  for (const auto& entry : report.metrics.assists_used) {
-    assists[entry.first] = entry.second;
-  }
-  metrics["assists_used"] = assists;
-  if (report.metrics.first_input_rt_ms.has_value()) {
-    metrics["first_input_rt_ms"] = report.metrics.first_input_rt_ms.value();
-  } else {
-    metrics["first_input_rt_ms"] = nullptr;
+  {
+    auto& obj = metrics.get_object();
+    obj.emplace("rt_ms", report.metrics.rt_ms);
+    obj.emplace("attempts", report.metrics.attempts);
+    obj.emplace("question_count", report.metrics.question_count);
+    nlohmann::json assists = nlohmann::json::object();
+    auto& assists_obj = assists.get_object();
+    for (const auto& entry : report.metrics.assists_used) {
+      assists_obj.emplace(entry.first, entry.second);
+    }
+    obj.emplace("assists_used", std::move(assists));
+    if (report.metrics.first_input_rt_ms.has_value()) {
+      obj.emplace("first_input_rt_ms", report.metrics.first_input_rt_ms.value());
+    } else {
+      obj.emplace("first_input_rt_ms", nullptr);
+    }
   }
-  json_report["metrics"] = metrics;
+  json_report["metrics"] = std::move(metrics);
   nlohmann::json attempts = nlohmann::json::array();
+  attempts.reserve(report.attempts.size());
   for (const auto& attempt : report.attempts) {
     nlohmann::json entry = nlohmann::json::object();
     entry["label"] = attempt.label;
@@ -1402,7 +1541,16 @@ nlohmann::json to_json(const ResultReport& report) {
   return json_report;
 }
 
-ResultReport result_report_from_json(const nlohmann::json& json_report) {
+// `owned` is true when the caller handed the report over by rvalue; attempt
+// fragments - the only arbitrary subtrees in a report - are then moved out
+// instead of cloned. The cast is sound because the sole owner is the
+// caller-provided temporary.
+static ResultReport result_report_from_json_impl(const nlohmann::json& json_report,
+                                                 bool owned) {
+  const auto take_fragment = [owned](const nlohmann::json& fragment) {
+    return owned ? typed_from_json(std::move(const_cast<nlohmann::json&>(fragment)))
+                 : typed_from_json(fragment);
+  };
   ResultReport report;
   report.question_id = json_report["question_id"].get<std::string>();
   report.final_answer = answer_payload_v2_from_json(json_report["final_answer"]);
@@ -1417,30 +1565,39 @@ ResultReport result_report_from_json(const nlohmann::json& json_report) {
   }
   report.metrics.assists_used.clear();
   const auto& assists = metrics["assists_used"].get_object();
+  report.metrics.assists_used.reserve(assists.size());
   for (const auto& entry : assists) {
-    report.metrics.assists_used[entry.first] = entry.second.get<int>();
+    report.metrics.assists_used.emplace_back(entry.first, entry.second.get<int>());
   }
   if (!metrics["first_input_rt_ms"].is_null()) {
     report.metrics.first_input_rt_ms = metrics["first_input_rt_ms"].get<int>();
   }
   report.attempts.clear();
-  if (json_report.contains("attempts") && json_report["attempts"].is_array()) {
-    for (const auto& item : json_report["attempts"].get_array()) {
+  // One map lookup per field instead of the old contains()+operator[] pairs;
+  // with five fields per attempt the double lookups dominated this loop.
+  if (const auto* attempts = json_report.find_member("attempts");
+      attempts && attempts->is_array()) {
+    report.attempts.reserve(attempts->get_array().size());
+    for (const auto& item : attempts->get_array()) {
       ResultReport::AttemptDetail detail;
-      detail.label = item.contains("label") && item["label"].is_string()
-                         ? item["label"].get<std::string>()
-                         : std::string();
-      detail.correct = item.contains("correct") && item["correct"].is_boolean()
-                           ? item["correct"].get<bool>()
-                           : false;
-      detail.attempts = item.contains("attempts") && item["attempts"].is_number_integer()
-                            ? item["attempts"].get<int>()
-                            : 0;
-      if (item.contains("answer_fragment") && !item["answer_fragment"].is_null()) {
-        detail.answer_fragment = typed_from_json(item["answer_fragment"]);
+      if (const auto* label = item.find_member("label"); label && label->is_string()) {
+        detail.label = label->get_string();
+      }
+      if (const auto* correct = item.find_member("correct");
+          correct && correct->is_boolean()) {
+        detail.correct = correct->get_boolean_unchecked();
+      }
+      if (const auto* attempt_count = item.find_member("attempts");
+          attempt_count && attempt_count->is_number_integer()) {
+        detail.attempts = static_cast<int>(attempt_count->get_integer_unchecked());
       }
-      if (item.contains("expected_fragment") && !item["expected_fragment"].is_null()) {
-        detail.expected_fragment = typed_from_json(item["expected_fragment"]);
+      if (const auto* fragment = item.find_member("answer_fragment");
+          fragment && !fragment->is_null()) {
+        detail.answer_fragment = take_fragment(*fragment);
+      }
+      if (const auto* fragment = item.find_member("expected_fragment");
+          fragment && !fragment->is_null()) {
+        detail.expected_fragment = take_fragment(*fragment);
       }
       report.attempts.push_back(std::move(detail));
     }
@@ -1448,6 +1605,14 @@ ResultReport result_report_from_json(const nlohmann::json& json_report) {
   return report;
 }
 
+ResultReport result_report_from_json(const nlohmann::json& json_report) {
+  return result_report_from_json_impl(json_report, false);
+}
+
+ResultReport result_report_from_json(nlohmann::json&& json_report) {
+  return result_report_from_json_impl(json_report, true);
+}
+
 nlohmann::json to_json(const SessionSummary& summary) {
   nlohmann::json json_summary = nlohmann::json::object();
   json_summary["session_id"] = summary.session_id;
@@ -1472,36 +1637,40 @@ nlohmann::json to_json(const MemoryPackage& package) {
   if (package.adaptive.has_value()) {
     const auto& adaptive = package.adaptive.value();
     nlohmann::json json_adaptive = nlohmann::json::object();
-    json_adaptive["has_score"] = adaptive.has_score;
-    json_adaptive["bout_average"] = adaptive.bout_average;
-    json_adaptive["graduate_threshold"] = adaptive.graduate_threshold;
-    json_adaptive["level_up"] = adaptive.level_up;
+    auto& adaptive_obj = json_adaptive.get_object();
+    adaptive_obj.emplace("has_score", adaptive.has_score);
+    adaptive_obj.emplace("bout_average", adaptive.bout_average);
+    adaptive_obj.emplace("graduate_threshold", adaptive.graduate_threshold);
+    adaptive_obj.emplace("level_up", adaptive.level_up);
     nlohmann::json drills = nlohmann::json::object();
+    auto& drills_obj = drills.get_object();
     for (const auto& entry : adaptive.drills) {
       nlohmann::json drill = nlohmann::json::object();
-      drill["family"] = entry.second.family;
+      auto& drill_obj = drill.get_object();
+      drill_obj.emplace("family", entry.second.family);
       if (entry.second.ema_score.has_value()) {
-        drill["ema_score"] = entry.second.ema_score.value();
+        drill_obj.emplace("ema_score", entry.second.ema_score.value());
       } else {
-        drill["ema_score"] = nullptr;
+        drill_obj.emplace("ema_score", nullptr);
       }
-      drills[entry.first] = std::move(drill);
+      drills_obj.emplace(entry.first, std::move(drill));
     }
-    json_adaptive["drills"] = std::move(drills);
+    adaptive_obj.emplace("drills", std::move(drills));
     if (adaptive.level.has_value()) {
       const auto& level = adaptive.level.value();
       nlohmann::json json_level = nlohmann::json::object();
-      json_level["track_index"] = level.track_index;
-      json_level["track_name"] = level.track_name;
-      json_level["current_level"] = level.current_level;
+      auto& level_obj = json_level.get_object();
+      level_obj.emplace("track_index", level.track_index);
+      level_obj.emplace("track_name", level.track_name);
+      level_obj.emplace("current_level", level.current_level);
       if (level.suggested_level.has_value()) {
-        json_level["suggested_level"] = level.suggested_level.value();
+        level_obj.emplace("suggested_level", level.suggested_level.value());
       } else {
-        json_level["suggested_level"] = nullptr;
+        level_obj.emplace("suggested_level", nullptr);
       }
-      json_adaptive["level"] = std::move(json_level);
+      adaptive_obj.emplace("level", std::move(json_level));
     } else {
-      json_adaptive["level"] = nullptr;
+      adaptive_obj.emplace("level", nullptr);
     }
     json_package["adaptive"] = std::move(json_adaptive);
   } else {
@@ -6,6 +6,9 @@ namespace ear::bridge {
 
 nlohmann::json to_json(const SessionSpec& spec);
 SessionSpec session_spec_from_json(const nlohmann::json& json_spec);
+// Rvalue overload: moves the sampler_params subtree out of the source
+// instead of cloning it.
+SessionSpec session_spec_from_json(nlohmann::json&& json_spec);
 
 nlohmann::json to_json(const QuestionBundle& bundle);
 QuestionBundle question_bundle_from_json(const nlohmann::json& json_bundle);
@@ -15,6 +18,9 @@ AssistBundle assist_bundle_from_json(const nlohmann::json& json_bundle);
 
 nlohmann::json to_json(const ResultReport& report);
 ResultReport result_report_from_json(const nlohmann::json& json_report);
+// Rvalue overload: moves attempt fragment subtrees out of the source
+// instead of cloning them.
+ResultReport result_report_from_json(nlohmann::json&& json_report);
 
 nlohmann::json to_json(const SessionSummary& summary);
 SessionSummary session_summary_from_json(const nlohmann::json& json_summary);
@@ -5,10 +5,8 @@
 
 #include <algorithm>
 #include <cctype>
-#include <iomanip>
-#include <mutex>
+#include <charconv>
 #include <optional>
-#include <sstream>
 #include <stdexcept>
 #include <string_view>
 #include <utility>
@@ -19,18 +17,14 @@ namespace {
 using Lesson = resources::ManifestView::Lesson;
 using DrillEntry = ear::builtin::catalog_numbered::DrillEntry;
 
-void ensure_factory_registered(DrillFactory& factory) {
-  static std::once_flag flag;
-  std::call_once(flag, [&factory]() { register_builtin_drills(factory); });
-}
-
-std::string to_lower(std::string_view text) {
-  std::string out;
-  out.reserve(text.size());
-  for (unsigned char ch : text) {
-    out.push_back(static_cast<char>(std::tolower(ch)));
-  }
-  return out;
+// Case-insensitive compare without materializing lowered copies; unequal
+// lengths bail before any character work.
+bool iequals(std::string_view a, std::string_view b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) ==
+                  std::tolower(static_cast<unsigned char>(y));
+         });
 }
 
 struct TrackCatalog {
@@ -47,9 +41,8 @@ std::vector<TrackCatalog> manifest_tracks(const resources::ManifestView& manifes
 }
 
 bool has_catalog(const std::vector<TrackCatalog>& tracks, std::string_view name) {
-  const auto lower = to_lower(name);
   return std::any_of(tracks.begin(), tracks.end(), [&](const TrackCatalog& track) {
-    return to_lower(track.name) == lower;
+    return iequals(track.name, name);
   });
 }
 
@@ -64,18 +57,17 @@ std::vector<std::string> all_catalog_names(const std::vector<TrackCatalog>& trac
 
 std::optional<std::string> resolve_catalog_name(const std::vector<TrackCatalog>& tracks,
                                                 const std::string& key) {
-  const std::string lower = to_lower(key);
   for (const auto& track : tracks) {
-    if (lower == to_lower(track.name)) {
+    if (iequals(key, track.name)) {
       return track.name;
     }
   }
 
   struct Alias {
-    std::string alias;
-    std::string canonical;
+    std::string_view alias;
+    std::string_view canonical;
   };
-  static const Alias kAliases[] = {
+  static constexpr Alias kAliases[] = {
       {"degree", "harmony"},
       {"degrees", "harmony"},
       {"degree_levels", "harmony"},
@@ -87,8 +79,8 @@ std::optional<std::string> resolve_catalog_name(const std::vector<TrackCatalog>&
       {"chord_sustain", "chord"},
   };
   for (const auto& alias : kAliases) {
-    if (lower == alias.alias && has_catalog(tracks, alias.canonical)) {
-      return alias.canonical;
+    if (iequals(key, alias.alias) && has_catalog(tracks, alias.canonical)) {
+      return std::string(alias.canonical);
     }
   }
 
@@ -110,6 +102,28 @@ DrillSpec make_spec_from_entry(const Lesson& lesson,
   return spec;
 }
 
+LevelInspector::TierSpecs build_level_specs(const Lesson& lesson) {
+  LevelInspector::TierSpecs tiers;
+  int ordinal = 0;
+  for (const auto& drill : lesson.drills) {
+    if (!drill.build) {
+      continue;
+    }
+    auto spec = make_spec_from_entry(lesson, drill, ordinal++);
+    const int tier_key = spec.tier.has_value() ? *spec.tier : -1;
+    auto it = std::find_if(tiers.begin(), tiers.end(),
+                           [&](const auto& entry) { return entry.first == tier_key; });
+    if (it == tiers.end()) {
+      tiers.emplace_back(tier_key, std::vector<DrillSpec>{});
+      it = std::prev(tiers.end());
+    }
+    it->second.push_back(std::move(spec));
+  }
+  std::sort(tiers.begin(), tiers.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  return tiers;
+}
+
 } // namespace
 
 LevelInspector::LevelInspector(std::filesystem::path resources_dir,
@@ -120,7 +134,9 @@ LevelInspector::LevelInspector(std::filesystem::path resources_dir,
       factory_(DrillFactory::instance()),
       manifest_(resources::manifest()) {
   (void)resources_dir;
-  ensure_factory_registered(factory_);
+  // Builtins dispatch statically inside the factory, so registration is an
+  // idempotent no-op hook; no call_once gate needed around it.
+  register_builtin_drills(factory_);
   load_catalog();
 }
 
@@ -135,12 +151,13 @@ void LevelInspector::load_catalog() {
   slots_.clear();
   question_counter_ = 0;
   next_slot_index_ = 0;
-  active_level_.reset();
-  active_tier_.reset();
+  active_level_ = -1;
+  active_tier_ = -1;
 
   allowed_catalogs_.clear();
   levels_.clear();
   lesson_lookup_.clear();
+  tier_cache_.clear();
 
   const auto tracks = manifest_tracks(manifest_);
   const bool load_all = catalog_basename_.empty() || catalog_basename_ == "all" ||
@@ -159,88 +176,137 @@ void LevelInspector::load_catalog() {
     allowed_catalogs_.push_back(*resolved);
   }
 
+  // In the common "all" case every track is allowed, so skip the name scan.
+  const auto track_allowed = [&](const TrackCatalog& track) {
+    return load_all ||
+           std::find(allowed_catalogs_.begin(), allowed_catalogs_.end(), track.name) !=
+               allowed_catalogs_.end();
+  };
+
+  std::size_t total_lessons = 0;
   for (const auto& track : tracks) {
-    if (std::find(allowed_catalogs_.begin(), allowed_catalogs_.end(), track.name) ==
-        allowed_catalogs_.end()) {
-      continue;
+    if (track.lessons && track_allowed(track)) {
+      total_lessons += track.lessons->size();
     }
-    if (!track.lessons) {
+  }
+  levels_.reserve(total_lessons);
+  lesson_lookup_.reserve(total_lessons);
+
+  for (const auto& track : tracks) {
+    if (!track.lessons || !track_allowed(track)) {
       continue;
     }
     for (const auto& lesson : *track.lessons) {
       levels_.push_back(lesson.lesson);
-      lesson_lookup_[lesson.lesson] = &lesson;
+      const auto it = std::find_if(
+          lesson_lookup_.begin(), lesson_lookup_.end(),
+          [&](const auto& entry) { return entry.first == lesson.lesson; });
+      if (it == lesson_lookup_.end()) {
+        lesson_lookup_.emplace_back(lesson.lesson, &lesson);
+      } else {
+        it->second = &lesson;  // later tracks win, as the old map insert did
+      }
     }
   }
 
+  std::sort(lesson_lookup_.begin(), lesson_lookup_.end());
   std::sort(levels_.begin(), levels_.end());
   levels_.erase(std::unique(levels_.begin(), levels_.end()), levels_.end());
 
   if (levels_.empty()) {
     throw std::runtime_error("LevelInspector: catalog '" + catalog_display_name_ + "' is empty");
   }
+
+  tier_cache_.reserve(levels_.size());
+  for (int level : levels_) {
+    if (const auto* lesson = lesson_for(level)) {
+      tier_cache_.emplace(level, build_level_specs(*lesson));
+    }
+  }
+
+  overview_cache_ = build_overview();
+  summary_cache_ = build_levels_summary();
+}
+
+const std::string& LevelInspector::overview() const {
+  return overview_cache_;
+}
+
+const std::string& LevelInspector::levels_summary() const {
+  return summary_cache_;
 }
 
-std::string LevelInspector::overview() const {
-  std::ostringstream oss;
-  oss << catalog_display_name_ << " levels\n";
+std::string LevelInspector::build_overview() const {
+  // Appends onto one growing string; the old ostringstream paid a locale and
+  // stream-state setup per call for what is plain concatenation.
+  std::string out;
+  // Rough per-level line estimate keeps the append loop from reallocating.
+  out.reserve(catalog_display_name_.size() + 16 + 48 * levels_.size());
+  out += catalog_display_name_;
+  out += " levels\n";
   for (int level : levels_) {
-    const auto tier_map = describe_level_specs(level);
-    oss << "  Level " << level << ": ";
+    const auto& tier_map = describe_level_specs(level);
+    out += "  Level ";
+    out += std::to_string(level);
+    out += ": ";
     if (tier_map.empty()) {
-      oss << "(no drills)\n";
+      out += "(no drills)\n";
       continue;
     }
     bool first_tier = true;
     for (const auto& [tier, specs] : tier_map) {
       if (!first_tier) {
-        oss << " | ";
+        out += " | ";
       }
       first_tier = false;
-      oss << "tier " << tier << " -> [";
+      out += "tier ";
+      out += std::to_string(tier);
+      out += " -> [";
       bool first_id = true;
       for (const auto& spec : specs) {
         if (!first_id) {
-          oss << ", ";
+          out += ", ";
         }
         first_id = false;
-        oss << spec.id;
+        out += spec.id;
       }
-      oss << "]";
+      out += "]";
     }
-    oss << "\n";
+    out += "\n";
   }
-  return oss.str();
+  return out;
 }
 
-std::string LevelInspector::levels_summary() const {
+std::string LevelInspector::build_levels_summary() const {
   if (levels_.empty()) {
     return "Levels: (none)";
   }
-  std::ostringstream oss;
-  oss << "Levels: ";
+  std::string out;
+  out.reserve(8 + 12 * levels_.size());
+  out += "Levels: ";
   bool first_level = true;
   for (int level : levels_) {
     if (!first_level) {
-      oss << ", ";
+      out += ", ";
     }
     first_level = false;
-    const auto tier_map = describe_level_specs(level);
-    oss << level << " (";
+    const auto& tier_map = describe_level_specs(level);
+    out += std::to_string(level);
+    out += " (";
     bool first_tier = true;
     for (const auto& [tier, _] : tier_map) {
       if (!first_tier) {
-        oss << ",";
+        out += ",";
       }
       first_tier = false;
-      oss << tier;
+      out += std::to_string(tier);
     }
-    oss << ")";
+    out += ")";
   }
-  return oss.str();
+  return out;
 }
 
-std::vector<int> LevelInspector::known_levels() const {
+const std::vector<int>& LevelInspector::known_levels() const {
   return levels_;
 }
 
@@ -249,7 +315,7 @@ std::vector<int> LevelInspector::tiers_for_level(int level) const {
   if (!std::binary_search(levels_.begin(), levels_.end(), level)) {
     return tiers;
   }
-  const auto tier_map = describe_level_specs(level);
+  const auto& tier_map = describe_level_specs(level);
   tiers.reserve(tier_map.size());
   for (const auto& [tier, _] : tier_map) {
     tiers.push_back(tier);
@@ -260,17 +326,20 @@ std::vector<int> LevelInspector::tiers_for_level(int level) const {
 std::vector<LevelCatalogEntry> LevelInspector::catalog_entries() const {
   std::vector<LevelCatalogEntry> entries;
   for (int level : levels_) {
-    const auto tier_map = describe_level_specs(level);
+    const auto& tier_map = describe_level_specs(level);
     for (const auto& [tier, specs] : tier_map) {
       if (specs.empty()) {
         continue;
       }
-      std::ostringstream oss;
-      oss << level << "-" << tier << ": " << specs.front().id;
       LevelCatalogEntry entry;
       entry.level = level;
       entry.tier = tier;
-      entry.label = oss.str();
+      entry.label.reserve(16 + specs.front().id.size());
+      entry.label += std::to_string(level);
+      entry.label += '-';
+      entry.label += std::to_string(tier);
+      entry.label += ": ";
+      entry.label += specs.front().id;
       entries.push_back(std::move(entry));
     }
   }
@@ -282,39 +351,34 @@ void LevelInspector::select(int level, int tier) {
     throw std::runtime_error("LevelInspector: unknown level " + std::to_string(level));
   }
 
-  auto tier_map = describe_level_specs(level);
-  auto tier_it = tier_map.find(tier);
-  if (tier_it == tier_map.end() || tier_it->second.empty()) {
+  const auto& tier_map = describe_level_specs(level);
+  const auto tier_it = std::lower_bound(
+      tier_map.begin(), tier_map.end(), tier,
+      [](const auto& entry, int value) { return entry.first < value; });
+  if (tier_it == tier_map.end() || tier_it->first != tier || tier_it->second.empty()) {
     throw std::runtime_error("LevelInspector: no drills for level " + std::to_string(level) +
                              ", tier " + std::to_string(tier));
   }
 
-  std::vector<DrillSpec> selected_specs = tier_it->second;
-  if (selected_specs.empty()) {
-    throw std::runtime_error("LevelInspector: tier " + std::to_string(tier) +
-                             " for level " + std::to_string(level) + " has no drills");
-  }
-  if (base_key_.has_value()) {
-    for (auto& spec : selected_specs) {
-      spec.key = *base_key_;
-    }
-  }
-
   slots_.clear();
+  slots_.reserve(tier_it->second.size());
   question_counter_ = 0;
   next_slot_index_ = 0;
   active_level_ = level;
   active_tier_ = tier;
 
   std::uint64_t seed = master_rng_;
-  for (const auto& spec : selected_specs) {
-    auto assignment = factory_.create(spec);
-    Slot slot;
-    slot.id = assignment.id;
-    slot.spec = assignment.spec;
+  for (const DrillSpec& cached : tier_it->second) {
+    // One copy per drill straight off the cache; the key override must land
+    // before create() so the module's configure() sees the session key.
+    DrillSpec spec = cached;
     if (base_key_.has_value()) {
-      slot.spec.key = *base_key_;
+      spec.key = *base_key_;
     }
+    auto assignment = factory_.create(std::move(spec));
+    Slot slot;
+    slot.id = std::move(assignment.id);
+    slot.spec = std::move(assignment.spec);
     slot.module = std::move(assignment.module);
     slot.rng_state = advance_rng(seed);
     slots_.push_back(std::move(slot));
@@ -327,14 +391,14 @@ void LevelInspector::select(int level, int tier) {
 }
 
 bool LevelInspector::has_selection() const {
-  return active_level_.has_value() && active_tier_.has_value() && !slots_.empty();
+  return active_level_ >= 0 && !slots_.empty();
 }
 
 std::optional<std::pair<int, int>> LevelInspector::selection() const {
   if (!has_selection()) {
     return std::nullopt;
   }
-  return std::make_pair(active_level_.value(), active_tier_.value());
+  return std::make_pair(active_level_, active_tier_);
 }
 
 QuestionBundle LevelInspector::next() {
@@ -347,43 +411,41 @@ QuestionBundle LevelInspector::next() {
   auto& slot = slots_[next_slot_index_];
   auto bundle = slot.module->next_question(slot.rng_state);
   bundle.question_id = make_question_id();
-  next_slot_index_ = (next_slot_index_ + 1) % slots_.size();
+  // Compare-and-wrap instead of % - the predictor learns the wrap point,
+  // where a modulo pays a runtime integer division every question.
+  ++next_slot_index_;
+  if (next_slot_index_ == slots_.size()) {
+    next_slot_index_ = 0;
+  }
   return bundle;
 }
 
 std::string LevelInspector::make_question_id() {
-  std::ostringstream oss;
-  oss << "li-";
-  oss.width(3);
-  oss.fill('0');
-  oss << ++question_counter_;
-  return oss.str();
+  // "li-" plus the counter zero-padded to three digits; runs on every
+  // next() call, so the id is formatted with to_chars on the stack instead
+  // of a freshly constructed ostringstream.
+  char digits[20];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), ++question_counter_);
+  const std::size_t len = static_cast<std::size_t>(result.ptr - digits);
+  std::string id = "li-";
+  for (std::size_t i = len; i < 3; ++i) {
+    id += '0';
+  }
+  id.append(digits, len);
+  return id;
 }
 
 const Lesson* LevelInspector::lesson_for(int level) const {
-  const auto it = lesson_lookup_.find(level);
-  if (it == lesson_lookup_.end()) {
-    return nullptr;
-  }
-  return it->second;
+  const auto it = std::lower_bound(
+      lesson_lookup_.begin(), lesson_lookup_.end(), level,
+      [](const auto& entry, int value) { return entry.first < value; });
+  return it != lesson_lookup_.end() && it->first == level ? it->second : nullptr;
 }
 
-std::map<int, std::vector<DrillSpec>> LevelInspector::describe_level_specs(int level) const {
-  std::map<int, std::vector<DrillSpec>> tiers;
-  const auto* lesson = lesson_for(level);
-  if (!lesson) {
-    return tiers;
-  }
-  int ordinal = 0;
-  for (const auto& drill : lesson->drills) {
-    if (!drill.build) {
-      continue;
-    }
-    auto spec = make_spec_from_entry(*lesson, drill, ordinal++);
-    const int tier_key = spec.tier.has_value() ? *spec.tier : -1;
-    tiers[tier_key].push_back(std::move(spec));
-  }
-  return tiers;
+const LevelInspector::TierSpecs& LevelInspector::describe_level_specs(int level) const {
+  static const TierSpecs kEmpty;
+  const auto it = tier_cache_.find(level);
+  return it != tier_cache_.end() ? it->second : kEmpty;
 }
 
 } // namespace ear
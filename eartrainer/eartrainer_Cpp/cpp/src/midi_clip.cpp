@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <utility>
 
 namespace ear {
 
@@ -24,12 +25,17 @@ MidiClipBuilder::MidiClipBuilder(int tempo_bpm, int ppq) {
   clip_.length_ticks = 0;
   clip_.tracks.clear();
   clip_.format = "midi-clip/v1";
+  ticks_per_ms_ = (static_cast<double>(tempo_bpm) * static_cast<double>(ppq)) / 60000.0;
 }
 
 int MidiClipBuilder::ms_to_ticks(int dur_ms) const {
-  const double ticks_per_ms = (static_cast<double>(clip_.tempo_bpm) * static_cast<double>(clip_.ppq)) /
-                              60000.0;
-  return static_cast<int>(std::lround(dur_ms * ticks_per_ms));
+  // Exact round-half-away integer form of dur_ms * tempo * ppq / 60000; the
+  // inputs are all ints, so there is no reason to detour through a double
+  // multiply plus lround per note.
+  const std::int64_t num =
+      static_cast<std::int64_t>(dur_ms) * clip_.tempo_bpm * clip_.ppq;
+  constexpr std::int64_t den = 60000;
+  return static_cast<int>((num + (num >= 0 ? den / 2 : -den / 2)) / den);
 }
 
 int MidiClipBuilder::beats_to_ticks(Beats beats) const {
@@ -37,6 +43,17 @@ int MidiClipBuilder::beats_to_ticks(Beats beats) const {
   return static_cast<int>(std::lround(dur_ticks));
 }
 
+void MidiClipBuilder::reserve_tracks(std::size_t track_count) {
+  clip_.tracks.reserve(track_count);
+}
+
+void MidiClipBuilder::reserve_notes(int track_index, std::size_t note_count) {
+  ensure_track_index(track_index);
+  auto& events = clip_.tracks[static_cast<std::size_t>(track_index)].events;
+  // Each note expands to a note_on/note_off pair.
+  events.reserve(events.size() + 2 * note_count);
+}
+
 int MidiClipBuilder::add_track(const std::string& name, int channel, int program) {
   MidiTrack track;
   track.name = name;
@@ -62,6 +79,13 @@ void MidiClipBuilder::add_event(int track_index, const MidiEvent& event) {
   update_length(event.t);
 }
 
+void MidiClipBuilder::add_event(int track_index, MidiEvent&& event) {
+  ensure_track_index(track_index);
+  const int t = event.t;
+  clip_.tracks[static_cast<std::size_t>(track_index)].events.push_back(std::move(event));
+  update_length(t);
+}
+
 void MidiClipBuilder::add_note_ticks(int track_index, int start_ticks, int dur_ticks, int note,
                                std::optional<int> velocity) {
   ensure_track_index(track_index);
@@ -70,20 +94,26 @@ void MidiClipBuilder::add_note_ticks(int track_index, int start_ticks, int dur_t
   const int clamped_note = clamp_midi_note(note);
   const int vel_value = clamp_velocity(velocity.value_or(90));
 
+  const int off_t = clamped_start + clamped_dur;
+
+  // Resolve the track once and append the pair back-to-back; going through
+  // add_event would re-validate the index and update the length per event.
+  auto& events = clip_.tracks[static_cast<std::size_t>(track_index)].events;
   MidiEvent on;
   on.t = clamped_start;
-  on.type = "note_on";
+  on.type = MidiEventType::NoteOn;
   on.note = clamped_note;
   on.vel = vel_value;
-  add_event(track_index, on);
+  events.push_back(std::move(on));
 
   MidiEvent off;
-  off.t = clamped_start + clamped_dur;
-  off.type = "note_off";
+  off.t = off_t;
+  off.type = MidiEventType::NoteOff;
   off.note = clamped_note;
-  add_event(track_index, off);
+  events.push_back(std::move(off));
 
-  update_length(off.t);
+  // off_t >= start, so one length update covers both events.
+  update_length(off_t);
 }
 
 void MidiClipBuilder::add_note(int track_index, Beats start, Beats dur, int note, std::optional<int> velocity){
@@ -94,7 +124,8 @@ void MidiClipBuilder::add_note(int track_index, Beats start, Beats dur, int note
 
 void MidiClipBuilder::add_chord(int track_index, Beats start, Beats dur, 
   const std::vector<int>& notes, std::optional<int> velocity){
-    for (int note : notes) { 
+    reserve_notes(track_index, notes.size());
+    for (int note : notes) {
       add_note(track_index, start, dur, note, velocity);
     }
   }
@@ -106,11 +137,15 @@ void MidiClipBuilder::set_length_ticks(int ticks) {
 MidiClip MidiClipBuilder::build() const {
   MidiClip result = clip_;
   int max_t = result.length_ticks;
+  const auto by_tick = [](const MidiEvent& lhs, const MidiEvent& rhs) {
+    return lhs.t < rhs.t;
+  };
   for (auto& track : result.tracks) {
-    std::stable_sort(track.events.begin(), track.events.end(),
-                     [](const MidiEvent& lhs, const MidiEvent& rhs) {
-                       return lhs.t < rhs.t;
-                     });
+    // Builders emit notes mostly in timeline order, so a linear is_sorted
+    // check usually replaces the stable_sort outright.
+    if (!std::is_sorted(track.events.begin(), track.events.end(), by_tick)) {
+      std::stable_sort(track.events.begin(), track.events.end(), by_tick);
+    }
     for (const auto& ev : track.events) {
       max_t = std::max(max_t, ev.t);
     }
@@ -120,40 +155,47 @@ MidiClip MidiClipBuilder::build() const {
 }
 
 nlohmann::json to_json(const MidiClip& clip) {
+  // Fields emplace straight onto each object_t; operator[] would default
+  // construct a node and assign over it per key (see the bridge encoders).
   nlohmann::json json_clip = nlohmann::json::object();
-  json_clip["format"] = clip.format;
-  json_clip["ppq"] = clip.ppq;
-  json_clip["tempo_bpm"] = clip.tempo_bpm;
-  json_clip["length_ticks"] = clip.length_ticks;
+  auto& clip_obj = json_clip.get_object();
+  clip_obj.emplace("format", clip.format);
+  clip_obj.emplace("ppq", clip.ppq);
+  clip_obj.emplace("tempo_bpm", clip.tempo_bpm);
+  clip_obj.emplace("length_ticks", clip.length_ticks);
   nlohmann::json tracks = nlohmann::json::array();
+  tracks.reserve(clip.tracks.size());
   for (const auto& track : clip.tracks) {
     nlohmann::json json_track = nlohmann::json::object();
-    json_track["name"] = track.name;
-    json_track["channel"] = track.channel;
-    json_track["program"] = track.program;
+    auto& track_obj = json_track.get_object();
+    track_obj.emplace("name", track.name);
+    track_obj.emplace("channel", track.channel);
+    track_obj.emplace("program", track.program);
     nlohmann::json events = nlohmann::json::array();
+    events.reserve(track.events.size());
     for (const auto& ev : track.events) {
       nlohmann::json json_event = nlohmann::json::object();
-      json_event["t"] = ev.t;
-      json_event["type"] = ev.type;
+      auto& event_obj = json_event.get_object();
+      event_obj.emplace("t", ev.t);
+      event_obj.emplace("type", midi_event_type_name(ev.type));
       if (ev.note.has_value()) {
-        json_event["note"] = ev.note.value();
+        event_obj.emplace("note", ev.note.value());
       }
       if (ev.vel.has_value()) {
-        json_event["vel"] = ev.vel.value();
+        event_obj.emplace("vel", ev.vel.value());
       }
       if (ev.control.has_value()) {
-        json_event["control"] = ev.control.value();
+        event_obj.emplace("control", ev.control.value());
       }
       if (ev.value.has_value()) {
-        json_event["value"] = ev.value.value();
+        event_obj.emplace("value", ev.value.value());
       }
       events.push_back(std::move(json_event));
     }
-    json_track["events"] = std::move(events);
+    track_obj.emplace("events", std::move(events));
     tracks.push_back(std::move(json_track));
   }
-  json_clip["tracks"] = std::move(tracks);
+  clip_obj.emplace("tracks", std::move(tracks));
   return json_clip;
 }
 
@@ -16,14 +16,14 @@
 #include <array>
 #include <cctype>
 #include <filesystem>
+#include <charconv>
 #include <cmath>
-#include <mutex>
 #include <memory>
 #include <optional>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 #include <cstdlib>
 
@@ -34,12 +34,18 @@ const std::array<std::string, 12> kChromaticKeys = {
     "C", "Db", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B"};
 
 std::string make_question_id(std::size_t index) {
-  std::ostringstream oss;
-  oss << "q-";
-  oss.width(3);
-  oss.fill('0');
-  oss << index + 1;
-  return oss.str();
+  // Formatted on the stack with to_chars and zero-padded to three digits;
+  // this runs once per question created, where the old ostringstream paid a
+  // stream construction and two allocations per id.
+  char digits[20];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), index + 1);
+  const std::size_t len = static_cast<std::size_t>(result.ptr - digits);
+  std::string id = "q-";
+  for (std::size_t i = len; i < 3; ++i) {
+    id += '0';
+  }
+  id.append(digits, len);
+  return id;
 }
 
 bool session_debug_enabled() {
@@ -67,27 +73,64 @@ std::string factory_family_for(const std::string& kind) {
   return kind;
 }
 
+const std::filesystem::path& resources_root() {
+  // Resolved once per process; every adaptive/inspector session used to
+  // re-stat the candidate directories.
+  static const std::filesystem::path dir = [] {
+    std::filesystem::path d = "resources";
+    if (!std::filesystem::exists(d)) {
+      d = std::filesystem::path("eartrainer/eartrainer_Cpp/resources");
+    }
+    return d;
+  }();
+  return dir;
+}
+
 DrillFactory& ensure_factory() {
-  static std::once_flag flag;
+  // Builtins dispatch statically inside the factory; registration is an
+  // idempotent no-op hook, so the old call_once gate bought nothing.
   auto& factory = DrillFactory::instance();
-  std::call_once(flag, [&factory]() { register_builtin_drills(factory); });
+  register_builtin_drills(factory);
   return factory;
 }
 
+struct SubmitCache {
+  ResultReport report;
+  bool is_summary = false;
+  std::optional<QuestionBundle> question;
+  std::optional<SessionSummary> summary;
+};
+
 struct QuestionState {
   std::string id;
-  std::optional<QuestionBundle> bundle;
+  // Heap-held rather than inline optionals: a lazy manual session keeps N of
+  // these mostly-empty states in a vector, and a null pointer costs 8 bytes
+  // per slot where an engaged-or-not bundle/cache would cost its full size.
+  std::unique_ptr<QuestionBundle> bundle;
   bool served = false;
   bool answered = false;
   std::optional<std::string> adaptive_question_id;
+  std::unique_ptr<SubmitCache> cached_response;
 };
 
-struct SubmitCache {
-  ResultReport report;
-  bool is_summary = false;
-  std::optional<QuestionBundle> question;
-  std::optional<SessionSummary> summary;
-};
+// Engine question ids carry their 1-based index after the prefix ("q-007",
+// "li-012"), so a submitted id resolves by parsing instead of a string-keyed
+// map lookup. Callers confirm the stored id matches the report before
+// trusting the index, which also rejects ids minted by another session.
+std::optional<std::size_t> parse_question_index(std::string_view id) {
+  const std::size_t dash = id.find('-');
+  if (dash == std::string_view::npos || dash + 1 >= id.size()) {
+    return std::nullopt;
+  }
+  std::uint64_t value = 0;
+  const char* const first = id.data() + dash + 1;
+  const char* const last = id.data() + id.size();
+  const auto result = std::from_chars(first, last, value);
+  if (result.ec != std::errc() || result.ptr != last || value == 0) {
+    return std::nullopt;
+  }
+  return static_cast<std::size_t>(value - 1);
+}
 
 struct SessionData {
   SessionSpec spec;
@@ -96,9 +139,12 @@ struct SessionData {
   std::uint64_t rng_state = 0;
   bool eager_materialised = false;
   std::vector<QuestionState> questions;
-  std::unordered_map<std::string, std::size_t> id_lookup;
-  std::unordered_map<std::string, SubmitCache> submit_cache;
   std::vector<ResultReport> result_log;
+  // Summary inputs accumulated as each result arrives, so completion pays a
+  // constant-time build instead of a pass over the whole log.
+  int summary_correct = 0;
+  double summary_rt_sum = 0.0;
+  nlohmann::json summary_results = nlohmann::json::array();
   std::optional<std::size_t> active_question;
   SessionSummary summary_cache;
   bool summary_ready = false;
@@ -110,19 +156,26 @@ struct SessionData {
   double adaptive_fitness = 0.5;
   std::size_t adaptive_target_questions = 0;
   std::size_t adaptive_asked = 0;
-  std::unordered_map<std::string, SessionSpec> adaptive_specs;
-  std::unordered_map<std::string, std::size_t> adaptive_counts;
   bool adaptive_bout_score_valid = false;
   double adaptive_bout_score = 0.0;
   std::vector<std::optional<double>> adaptive_drill_scores;
   std::optional<AdaptiveDrills::BoutOutcome> adaptive_bout_outcome;
+  // result_log size at the last attach_adaptive_summary; repeated calls for
+  // an unchanged log (post-completion next_question, end_session) skip
+  // re-running end_bout and rebuilding the adaptive totals.
+  std::size_t adaptive_summary_results = static_cast<std::size_t>(-1);
   std::unique_ptr<LevelInspector> level_inspector;
   std::optional<int> inspector_level;
   std::optional<int> inspector_tier;
 };
 
-QuestionBundle make_bundle(SessionData& session, QuestionState& state) {
-  if (!state.bundle.has_value()) {
+// The bundle is built once when the question materialises and never mutates
+// afterwards, so callers get a reference to the stored copy; the one
+// unavoidable deep copy happens where the reference is put into a Next or a
+// cache slot, not here.
+const QuestionBundle& make_bundle(SessionData& session, QuestionState& state) {
+  (void)session;
+  if (!state.bundle) {
     throw std::runtime_error("Question output missing");
   }
   return *state.bundle;
@@ -133,11 +186,11 @@ void ensure_question(SessionData& session, std::size_t index) {
     throw std::out_of_range("question index out of range");
   }
   auto& state = session.questions[index];
-  if (!state.bundle.has_value()) {
+  if (!state.bundle) {
     auto bundle = session.module->next_question(session.rng_state);
     // apply_prompt_rendering(session.drill_spec, bundle);
     bundle.question_id = state.id;
-    state.bundle = std::move(bundle);
+    state.bundle = std::make_unique<QuestionBundle>(std::move(bundle));
   }
 }
 
@@ -145,45 +198,61 @@ void materialise_all(SessionData& session) {
   if (session.eager_materialised) {
     return;
   }
-  for (std::size_t i = 0; i < session.questions.size(); ++i) {
-    ensure_question(session, i);
+  // Runs before anything can have materialised a question (the lazy
+  // ensure/prefetch path is gated on !eager_materialised and submits require
+  // a served question), so the loop assigns straight through without the
+  // per-question presence and range checks ensure_question repeats.
+  for (auto& state : session.questions) {
+    auto bundle = session.module->next_question(session.rng_state);
+    bundle.question_id = state.id;
+    state.bundle = std::make_unique<QuestionBundle>(std::move(bundle));
   }
   session.eager_materialised = true;
 }
 
+// Appends the report to the log and folds it into the running summary
+// accumulators; every submit path records through here.
+void record_result(SessionData& session, const ResultReport& report) {
+  session.result_log.push_back(report);
+  if (report.correct) {
+    ++session.summary_correct;
+  }
+  session.summary_rt_sum += static_cast<double>(report.metrics.rt_ms);
+  nlohmann::json item = nlohmann::json::object();
+  auto& obj = item.get_object();
+  obj.emplace("question_id", report.question_id);
+  obj.emplace("correct", report.correct);
+  obj.emplace("rt_ms", report.metrics.rt_ms);
+  obj.emplace("score", scoring::score_question(report));
+  session.summary_results.get_array().push_back(std::move(item));
+}
+
 SessionSummary build_summary(const std::string& session_id, const std::string& label,
-                             const std::vector<ResultReport>& results) {
+                             SessionData& session) {
   SessionSummary summary;
   summary.session_id = session_id;
+  const std::size_t count = session.result_log.size();
   nlohmann::json totals = nlohmann::json::object();
-  int correct = 0;
-  for (const auto& r : results) {
-    if (r.correct) {
-      ++correct;
-    }
-  }
-  totals["correct"] = correct;
-  totals["incorrect"] = static_cast<int>(results.size()) - correct;
-  totals["avg_rt_ms"] = static_cast<int>(scoring::average_response_time(results));
-  summary.totals = totals;
+  totals["correct"] = session.summary_correct;
+  totals["incorrect"] = static_cast<int>(count) - session.summary_correct;
+  totals["avg_rt_ms"] = static_cast<int>(
+      count == 0 ? 0.0 : session.summary_rt_sum / static_cast<double>(count));
+  summary.totals = std::move(totals);
 
   nlohmann::json by_category = nlohmann::json::array();
   nlohmann::json entry = nlohmann::json::object();
   entry["label"] = label;
-  entry["score"] = scoring::aggregate_accuracy(results);
-  by_category.push_back(entry);
-  summary.by_category = by_category;
-
-  nlohmann::json res = nlohmann::json::array();
-  for (const auto& r : results) {
-    nlohmann::json item = nlohmann::json::object();
-    item["question_id"] = r.question_id;
-    item["correct"] = r.correct;
-    item["rt_ms"] = r.metrics.rt_ms;
-    item["score"] = scoring::score_question(r);
-    res.push_back(item);
-  }
-  summary.results = res;
+  entry["score"] = count == 0 ? 0.0
+                              : static_cast<double>(session.summary_correct) /
+                                    static_cast<double>(count);
+  by_category.push_back(std::move(entry));
+  summary.by_category = std::move(by_category);
+
+  // The per-result items were appended as each result arrived. Each
+  // summary_ready epoch builds at most once (set_level starts a new epoch),
+  // so the accumulated array is stolen, not copied.
+  summary.results = std::move(session.summary_results);
+  session.summary_results = nlohmann::json::array();
   return summary;
 }
 
@@ -191,6 +260,9 @@ void attach_adaptive_summary(SessionData& session) {
   if (!session.adaptive || !session.adaptive_drills) {
     return;
   }
+  if (session.adaptive_summary_results == session.result_log.size()) {
+    return;
+  }
   const auto report = session.adaptive_drills->end_bout();
   AdaptiveDrills::BoutOutcome outcome;
   outcome.graduate_threshold = report.graduate_threshold;
@@ -200,23 +272,28 @@ void attach_adaptive_summary(SessionData& session) {
     outcome.level_up = report.level_up;
   }
   session.adaptive_bout_outcome = outcome;
+  // One walk to the totals object; each operator[] chain re-resolved the
+  // json node and default-constructed before assigning, where
+  // insert_or_assign lands the value in one step (keys can already exist
+  // when a summary re-attaches after new results).
+  auto& totals = session.summary_cache.totals.get_object();
   if (report.has_score) {
     session.adaptive_bout_score_valid = true;
     session.adaptive_bout_score = report.bout_average;
-    session.summary_cache.totals["adaptive_bout_score"] = report.bout_average;
-    session.summary_cache.totals["adaptive_level_up"] = report.level_up;
-    session.summary_cache.totals["adaptive_level_up_threshold"] = report.graduate_threshold;
+    totals.insert_or_assign("adaptive_bout_score", nlohmann::json(report.bout_average));
+    totals.insert_or_assign("adaptive_level_up", nlohmann::json(report.level_up));
+    totals.insert_or_assign("adaptive_level_up_threshold",
+                            nlohmann::json(report.graduate_threshold));
   } else if (session.adaptive_bout_score_valid) {
-    session.summary_cache.totals["adaptive_bout_score"] = session.adaptive_bout_score;
+    totals.insert_or_assign("adaptive_bout_score", nlohmann::json(session.adaptive_bout_score));
   }
   if (report.level.has_value()) {
-    session.summary_cache.totals["adaptive_level_track"] = report.level->track_name;
-    session.summary_cache.totals["adaptive_level_current"] = report.level->current_level;
-    if (report.level->suggested_level.has_value()) {
-      session.summary_cache.totals["adaptive_level_suggested"] = *report.level->suggested_level;
-    } else {
-      session.summary_cache.totals["adaptive_level_suggested"] = nullptr;
-    }
+    totals.insert_or_assign("adaptive_level_track", nlohmann::json(report.level->track_name));
+    totals.insert_or_assign("adaptive_level_current", nlohmann::json(report.level->current_level));
+    totals.insert_or_assign("adaptive_level_suggested",
+                            report.level->suggested_level.has_value()
+                                ? nlohmann::json(*report.level->suggested_level)
+                                : nlohmann::json(nullptr));
   }
   if (!session.adaptive_drill_scores.empty()) {
     nlohmann::json drills = nlohmann::json::array();
@@ -227,16 +304,21 @@ void attach_adaptive_summary(SessionData& session) {
         drills.push_back(nullptr);
       }
     }
-    session.summary_cache.totals["adaptive_drill_scores"] = drills;
+    totals.insert_or_assign("adaptive_drill_scores", std::move(drills));
   }
   nlohmann::json drill_map = nlohmann::json::object();
+  auto& drill_obj = drill_map.get_object();
   for (const auto& entry : report.drill_scores) {
     nlohmann::json value = nlohmann::json::object();
-    value["family"] = entry.family;
-    value["ema_score"] = entry.score.has_value() ? nlohmann::json(*entry.score) : nlohmann::json(nullptr);
-    drill_map[entry.id] = std::move(value);
-  }
-  session.summary_cache.totals["adaptive_drill_score_map"] = std::move(drill_map);
+    auto& value_obj = value.get_object();
+    value_obj.emplace("family", entry.family);
+    value_obj.emplace("ema_score",
+                      entry.score.has_value() ? nlohmann::json(*entry.score)
+                                              : nlohmann::json(nullptr));
+    drill_obj.emplace(entry.id, std::move(value));
+  }
+  totals.insert_or_assign("adaptive_drill_score_map", std::move(drill_map));
+  session.adaptive_summary_results = session.result_log.size();
 }
 
 } // namespace
@@ -322,26 +404,32 @@ public:
   }
 
   nlohmann::json capabilities() const override {
-    nlohmann::json caps = nlohmann::json::object();
-    caps["version"] = "v1";
-    nlohmann::json drills = nlohmann::json::array();
-    drills.push_back("note");
-    drills.push_back("interval");
-    drills.push_back("melody");
-    drills.push_back("chord");
-    caps["drills"] = drills;
-    nlohmann::json assists = nlohmann::json::array();
-    assists.push_back("Replay");
-    assists.push_back("GuideTone");
-    assists.push_back("TempoDown");
-    assists.push_back("PathwayHint");
-    caps["assists"] = assists;
-    nlohmann::json session_assists = nlohmann::json::array();
-    for (const auto& kind : assistance::session_assist_kinds()) {
-      session_assists.push_back(kind);
-    }
-    caps["session_assists"] = session_assists;
-    return caps;
+    // Pure and identical on every call, so the document is assembled once;
+    // the interface returns by value, leaving one copy per call instead of a
+    // rebuild of three arrays of string nodes.
+    static const nlohmann::json kCaps = [] {
+      nlohmann::json caps = nlohmann::json::object();
+      caps["version"] = "v1";
+      nlohmann::json drills = nlohmann::json::array();
+      drills.push_back("note");
+      drills.push_back("interval");
+      drills.push_back("melody");
+      drills.push_back("chord");
+      caps["drills"] = std::move(drills);
+      nlohmann::json assists = nlohmann::json::array();
+      assists.push_back("Replay");
+      assists.push_back("GuideTone");
+      assists.push_back("TempoDown");
+      assists.push_back("PathwayHint");
+      caps["assists"] = std::move(assists);
+      nlohmann::json session_assists = nlohmann::json::array();
+      for (const auto& kind : assistance::session_assist_kinds()) {
+        session_assists.push_back(kind);
+      }
+      caps["session_assists"] = std::move(session_assists);
+      return caps;
+    }();
+    return kCaps;
   }
 
   nlohmann::json drill_param_spec() const override {
@@ -369,11 +457,9 @@ public:
         info["adaptive_fitness"] = session.adaptive_fitness;
         info["adaptive_asked"] = static_cast<int>(session.adaptive_asked);
         info["adaptive_target"] = static_cast<int>(session.adaptive_target_questions);
-        nlohmann::json counts = nlohmann::json::object();
-        for (const auto& kv : session.adaptive_counts) {
-          counts[kv.first] = static_cast<int>(kv.second);
-        }
-        info["drill_counts"] = counts;
+        // Per-drill attribution is not wired up yet; keep the key so
+        // callers see a stable shape.
+        info["drill_counts"] = nlohmann::json::object();
         if (session.adaptive_bout_score_valid) {
           info["adaptive_bout_score"] = session.adaptive_bout_score;
         }
@@ -447,13 +533,13 @@ public:
       if (session.mode == SessionMode::Adaptive) {
         if (!session.summary_ready) {
           session.summary_cache =
-              build_summary(session_id, session.spec.drill_kind, session.result_log);
+              build_summary(session_id, session.spec.drill_kind, session);
           session.summary_ready = true;
         }
         attach_adaptive_summary(session);
       } else {
         session.summary_cache =
-            build_summary(session_id, session.spec.drill_kind, session.result_log);
+            build_summary(session_id, session.spec.drill_kind, session);
         session.summary_ready = true;
       }
     } else if (session.mode == SessionMode::Adaptive) {
@@ -515,9 +601,11 @@ private:
   }
 
   std::string generate_session_id() {
-    std::ostringstream oss;
-    oss << "sess-" << (++session_counter_);
-    return oss.str();
+    char digits[20];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), ++session_counter_);
+    std::string id = "sess-";
+    id.append(digits, static_cast<std::size_t>(result.ptr - digits));
+    return id;
   }
 
   mutable std::unordered_map<std::string, SessionData> sessions_;
@@ -550,11 +638,12 @@ std::string SessionEngineImpl::create_manual_session(const SessionSpec& spec) {
   session.summary_cache.results = nlohmann::json::array();
 
   session.questions.reserve(spec.n_questions);
+  session.result_log.reserve(static_cast<std::size_t>(spec.n_questions));
+  session.summary_results.get_array().reserve(static_cast<std::size_t>(spec.n_questions));
   for (int i = 0; i < spec.n_questions; ++i) {
     QuestionState state;
     state.id = make_question_id(i);
-    session.id_lookup[state.id] = session.questions.size();
-    session.questions.push_back(state);
+    session.questions.push_back(std::move(state));
   }
 
   std::string session_id = generate_session_id();
@@ -585,7 +674,7 @@ std::string SessionEngineImpl::create_adaptive_session(const SessionSpec& spec)
     session.spec.tempo_bpm = 96;
   }
   if (session.spec.assistance_policy.empty()) {
-    session.spec.assistance_policy["Replay"] = 0;
+    session.spec.assistance_policy.emplace_back("Replay", 0);
   }
   if (session.spec.key.empty()) {
     std::uint64_t key_state = spec.seed == 0 ? 1 : spec.seed;
@@ -595,41 +684,45 @@ std::string SessionEngineImpl::create_adaptive_session(const SessionSpec& spec)
 
   session.adaptive_target_questions = spec.n_questions > 0 ? static_cast<std::size_t>(spec.n_questions)
                                                           : static_cast<std::size_t>(0);
-
-  if (spec.sampler_params.is_object() && spec.sampler_params.contains("initial_fitness")) {
-    const auto& value = spec.sampler_params["initial_fitness"];
-    if (value.is_number()) {
-      session.adaptive_fitness = value.get<double>();
+  if (session.adaptive_target_questions != 0) {
+    // Adaptive questions arrive one at a time; sizing the vectors to the
+    // bout target up front keeps the incremental push_backs from ever
+    // reallocating (and moving every QuestionState with its json payload).
+    session.questions.reserve(session.adaptive_target_questions);
+    session.result_log.reserve(session.adaptive_target_questions);
+    session.summary_results.get_array().reserve(session.adaptive_target_questions);
+  }
+
+  // One pass over sampler_params instead of a contains()+operator[] pair per
+  // key; the nodes needed later are remembered by pointer.
+  const nlohmann::json* sampler_levels = nullptr;
+  const nlohmann::json* legacy_level_node = nullptr;
+  if (spec.sampler_params.is_object()) {
+    for (const auto& entry : spec.sampler_params.get_object()) {
+      if (entry.first == "initial_fitness" && entry.second.is_number()) {
+        session.adaptive_fitness = entry.second.get<double>();
+      } else if (entry.first == "track_levels" && entry.second.is_array()) {
+        sampler_levels = &entry.second;
+      } else if (entry.first == "level" && entry.second.is_number_integer()) {
+        legacy_level_node = &entry.second;
+      }
     }
   }
 
   // Initialize AdaptiveDrills with catalog path and track levels
-  std::filesystem::path resources_dir = "resources";
-  if (!std::filesystem::exists(resources_dir)) {
-    resources_dir = std::filesystem::path("eartrainer/eartrainer_Cpp/resources");
-  }
-  session.adaptive_drills = std::make_unique<AdaptiveDrills>(resources_dir.string(), spec.seed);
+  session.adaptive_drills = std::make_unique<AdaptiveDrills>(resources_root().string(), spec.seed);
   auto track_count = session.adaptive_drills->track_count();
 
   session.track_levels = spec.track_levels;
-  if (session.track_levels.empty() && spec.sampler_params.is_object()) {
-    if (spec.sampler_params.contains("track_levels")) {
-      const auto& tl = spec.sampler_params["track_levels"];
-      if (tl.is_array()) {
-        for (const auto& entry : tl.get_array()) {
-          if (entry.is_number_integer()) {
-            session.track_levels.push_back(entry.get<int>());
-          }
-        }
+  if (session.track_levels.empty() && sampler_levels != nullptr) {
+    for (const auto& entry : sampler_levels->get_array()) {
+      if (entry.is_number_integer()) {
+        session.track_levels.push_back(entry.get<int>());
       }
     }
   }
   if (session.track_levels.empty()) {
-    int legacy_level = 1;
-    if (spec.sampler_params.is_object() && spec.sampler_params.contains("level")) {
-      const auto& lv = spec.sampler_params["level"];
-      if (lv.is_number_integer()) legacy_level = lv.get<int>();
-    }
+    const int legacy_level = legacy_level_node != nullptr ? legacy_level_node->get<int>() : 1;
     session.track_levels.push_back(legacy_level);
   }
   if (track_count > 0) {
@@ -675,13 +768,8 @@ std::string SessionEngineImpl::create_level_inspector_session(const SessionSpec&
   session.inspector_level = spec.inspect_level;
   session.inspector_tier = spec.inspect_tier;
 
-  std::filesystem::path resources_dir = "resources";
-  if (!std::filesystem::exists(resources_dir)) {
-    resources_dir = std::filesystem::path("eartrainer/eartrainer_Cpp/resources");
-  }
-
   session.level_inspector =
-      std::make_unique<LevelInspector>(resources_dir, "all_builtin", spec.seed);
+      std::make_unique<LevelInspector>(resources_root(), "all_builtin", spec.seed);
   session.level_inspector->set_base_spec(session.spec);
 
   if (session.inspector_level.has_value() && session.inspector_tier.has_value()) {
@@ -721,9 +809,10 @@ void SessionEngineImpl::set_level(const std::string& session_id, int level, int
   session.spec.inspect_level = level;
   session.spec.inspect_tier = tier;
   session.questions.clear();
-  session.id_lookup.clear();
-  session.submit_cache.clear();
   session.result_log.clear();
+  session.summary_correct = 0;
+  session.summary_rt_sum = 0.0;
+  session.summary_results = nlohmann::json::array();
   session.active_question.reset();
   session.summary_ready = false;
   session.summary_cache.results = nlohmann::json::array();
@@ -753,12 +842,7 @@ std::vector<LevelCatalogEntry> SessionEngineImpl::level_catalog_entries(const Se
   inspector_spec.mode = SessionMode::LevelInspector;
   inspector_spec.level_inspect = true;
 
-  std::filesystem::path resources_dir = "resources";
-  if (!std::filesystem::exists(resources_dir)) {
-    resources_dir = std::filesystem::path("eartrainer/eartrainer_Cpp/resources");
-  }
-
-  LevelInspector inspector(resources_dir, "all_builtin", inspector_spec.seed);
+  LevelInspector inspector(resources_root(), "all_builtin", inspector_spec.seed);
   inspector.set_base_spec(inspector_spec);
   return inspector.catalog_entries();
 }
@@ -773,7 +857,7 @@ SessionEngine::Next SessionEngineImpl::next_question_manual(const std::string& s
   if (session.result_log.size() >= session.questions.size()) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
     }
     return session.summary_cache;
@@ -784,7 +868,17 @@ SessionEngine::Next SessionEngineImpl::next_question_manual(const std::string& s
   }
 
   std::size_t index = session.result_log.size();
-  ensure_question(session, index);
+  // Once the session is fully materialised every bundle exists, so the
+  // per-question presence checks are dead and get skipped wholesale.
+  if (!session.eager_materialised) {
+    ensure_question(session, index);
+    // Warm one question ahead: bundles are drawn from the session RNG in
+    // index order either way, so prefetching is byte-identical to generating
+    // on demand, and the next submit/next cycle returns without generating.
+    if (index + 1 < session.questions.size()) {
+      ensure_question(session, index + 1);
+    }
+  }
   auto& state = session.questions[index];
   state.served = true;
   session.active_question = index;
@@ -794,52 +888,40 @@ SessionEngine::Next SessionEngineImpl::next_question_manual(const std::string& s
 SessionEngine::Next SessionEngineImpl::submit_result_manual(const std::string& session_id,
                                                             SessionData& session,
                                                             const ResultReport& report) {
-  auto cache_it = session.submit_cache.find(report.question_id);
-  if (cache_it != session.submit_cache.end()) {
-    if (cache_it->second.is_summary) {
-      return cache_it->second.summary.value();
-    }
-    return cache_it->second.question.value();
-  }
-
-  auto id_it = session.id_lookup.find(report.question_id);
-  if (id_it == session.id_lookup.end()) {
+  const auto index = parse_question_index(report.question_id);
+  if (!index.has_value() || index.value() >= session.questions.size() ||
+      session.questions[index.value()].id != report.question_id) {
     throw std::runtime_error("Unknown question id");
   }
-  auto& state = session.questions[id_it->second];
+  auto& state = session.questions[index.value()];
   if (!state.served) {
     throw std::runtime_error("Cannot submit result for unserved question");
   }
   if (!state.answered) {
-    session.result_log.push_back(report);
+    record_result(session, report);
     state.answered = true;
-    if (session.active_question == id_it->second) {
+    if (session.active_question == index.value()) {
       session.active_question.reset();
     }
   }
 
-  Next response;
-  SubmitCache submit_cache{report};
-
+  // Manual responses are deterministic - the same question's bundle, or the
+  // summary once the log is full - so a duplicate submit is answered by
+  // recomputing rather than from a cached deep copy per question. The
+  // adaptive and inspector paths still cache: their response is the next
+  // generated question, which cannot be rebuilt.
   if (session.result_log.size() >= session.questions.size()) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
     }
-    response = session.summary_cache;
-    submit_cache.is_summary = true;
-    submit_cache.summary = session.summary_cache;
-  } else {
-    ensure_question(session, id_it->second);
-    auto bundle = make_bundle(session, state);
-    response = bundle;
-    submit_cache.is_summary = false;
-    submit_cache.question = bundle;
+    return session.summary_cache;
   }
-
-  session.submit_cache[report.question_id] = submit_cache;
-  return response;
+  if (!session.eager_materialised) {
+    ensure_question(session, index.value());
+  }
+  return make_bundle(session, state);
 }
 
 SessionEngine::Next SessionEngineImpl::next_question_adaptive(const std::string& session_id,
@@ -859,7 +941,7 @@ SessionEngine::Next SessionEngineImpl::next_question_adaptive(const std::string&
   if (session.adaptive_drills && session.adaptive_drills->bout_finished()) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
       attach_adaptive_summary(session);
     }
@@ -874,7 +956,7 @@ SessionEngine::Next SessionEngineImpl::next_question_adaptive(const std::string&
       session.adaptive_asked >= session.adaptive_target_questions) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
       attach_adaptive_summary(session);
     }
@@ -892,11 +974,10 @@ SessionEngine::Next SessionEngineImpl::next_question_adaptive(const std::string&
   state.id = question_id;
   state.adaptive_question_id = bundle_from_ad.question_id;
   bundle_from_ad.question_id = question_id;
-  state.bundle = std::move(bundle_from_ad);
+  state.bundle = std::make_unique<QuestionBundle>(std::move(bundle_from_ad));
   state.served = true;
   state.answered = false;
 
-  session.id_lookup[question_id] = index;
   session.questions.push_back(std::move(state));
   session.active_question = index;
   session.adaptive_asked += 1;
@@ -930,11 +1011,10 @@ SessionEngine::Next SessionEngineImpl::next_question_level_inspector(const std::
   QuestionBundle bundle = session.level_inspector->next();
   QuestionState state;
   state.id = bundle.question_id;
-  state.bundle = bundle;
+  state.bundle = std::make_unique<QuestionBundle>(std::move(bundle));
   state.served = true;
   state.answered = false;
   const std::size_t index = session.questions.size();
-  session.id_lookup[state.id] = index;
   session.questions.push_back(std::move(state));
   session.active_question = index;
   return make_bundle(session, session.questions.back());
@@ -943,19 +1023,18 @@ SessionEngine::Next SessionEngineImpl::next_question_level_inspector(const std::
 SessionEngine::Next SessionEngineImpl::submit_result_adaptive(const std::string& session_id,
                                                               SessionData& session,
                                                               const ResultReport& report) {
-  auto cache_it = session.submit_cache.find(report.question_id);
-  if (cache_it != session.submit_cache.end()) {
-    if (cache_it->second.is_summary) {
-      return cache_it->second.summary.value();
-    }
-    return cache_it->second.question.value();
-  }
-
-  auto id_it = session.id_lookup.find(report.question_id);
-  if (id_it == session.id_lookup.end()) {
+  const auto index = parse_question_index(report.question_id);
+  if (!index.has_value() || index.value() >= session.questions.size() ||
+      session.questions[index.value()].id != report.question_id) {
     throw std::runtime_error("Unknown question id");
   }
-  auto& state = session.questions[id_it->second];
+  auto& state = session.questions[index.value()];
+  if (state.cached_response) {
+    if (state.cached_response->is_summary) {
+      return state.cached_response->summary.value();
+    }
+    return state.cached_response->question.value();
+  }
   if (!state.served) {
     throw std::runtime_error("Cannot submit result for unserved question");
   }
@@ -969,9 +1048,9 @@ SessionEngine::Next SessionEngineImpl::submit_result_adaptive(const std::string&
       session.adaptive_drill_scores = snapshot.drill_scores;
       session.adaptive_bout_outcome = session.adaptive_drills->current_bout_outcome();
     }
-    session.result_log.push_back(report);
+    record_result(session, report);
     state.answered = true;
-    if (session.active_question == id_it->second) {
+    if (session.active_question == index.value()) {
       session.active_question.reset();
     }
   }
@@ -989,16 +1068,17 @@ SessionEngine::Next SessionEngineImpl::submit_result_adaptive(const std::string&
   if (session_complete) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
-      attach_adaptive_summary(session);
     }
     attach_adaptive_summary(session);
     response = session.summary_cache;
     submit_cache.is_summary = true;
     submit_cache.summary = session.summary_cache;
   } else if (session.mode == SessionMode::Adaptive) {
-    session.submit_cache[report.question_id] = submit_cache;
+    // Store before recursing: next_question_adaptive may grow the questions
+    // vector and invalidate `state`.
+    state.cached_response = std::make_unique<SubmitCache>(std::move(submit_cache));
     return next_question_adaptive(session_id, session);
   } else {
     auto bundle = make_bundle(session, state);
@@ -1007,32 +1087,31 @@ SessionEngine::Next SessionEngineImpl::submit_result_adaptive(const std::string&
     submit_cache.question = bundle;
   }
 
-  session.submit_cache[report.question_id] = submit_cache;
+  state.cached_response = std::make_unique<SubmitCache>(std::move(submit_cache));
   return response;
 }
 
 SessionEngine::Next SessionEngineImpl::submit_result_level_inspector(
     const std::string& session_id, SessionData& session, const ResultReport& report) {
-  auto cache_it = session.submit_cache.find(report.question_id);
-  if (cache_it != session.submit_cache.end()) {
-    if (cache_it->second.is_summary) {
-      return cache_it->second.summary.value();
-    }
-    return cache_it->second.question.value();
-  }
-
-  auto id_it = session.id_lookup.find(report.question_id);
-  if (id_it == session.id_lookup.end()) {
+  const auto index = parse_question_index(report.question_id);
+  if (!index.has_value() || index.value() >= session.questions.size() ||
+      session.questions[index.value()].id != report.question_id) {
     throw std::runtime_error("Unknown question id");
   }
-  auto& state = session.questions[id_it->second];
+  auto& state = session.questions[index.value()];
+  if (state.cached_response) {
+    if (state.cached_response->is_summary) {
+      return state.cached_response->summary.value();
+    }
+    return state.cached_response->question.value();
+  }
   if (!state.served) {
     throw std::runtime_error("Cannot submit result for unserved question");
   }
   if (!state.answered) {
-    session.result_log.push_back(report);
+    record_result(session, report);
     state.answered = true;
-    if (session.active_question == id_it->second) {
+    if (session.active_question == index.value()) {
       session.active_question.reset();
     }
   }
@@ -1047,7 +1126,7 @@ SessionEngine::Next SessionEngineImpl::submit_result_level_inspector(
   if (limited) {
     if (!session.summary_ready) {
       session.summary_cache =
-          build_summary(session_id, session.spec.drill_kind, session.result_log);
+          build_summary(session_id, session.spec.drill_kind, session);
       session.summary_ready = true;
     }
     response = session.summary_cache;
@@ -1061,19 +1140,22 @@ SessionEngine::Next SessionEngineImpl::submit_result_level_inspector(
     QuestionBundle next_bundle = session.level_inspector->next();
     QuestionState next_state;
     next_state.id = next_bundle.question_id;
-    next_state.bundle = next_bundle;
+    next_state.bundle = std::make_unique<QuestionBundle>(next_bundle);
     next_state.served = true;
     next_state.answered = false;
-    const std::size_t index = session.questions.size();
-    session.id_lookup[next_state.id] = index;
-    session.questions.push_back(std::move(next_state));
-    session.active_question = index;
     response = next_bundle;
     submit_cache.is_summary = false;
-    submit_cache.question = next_bundle;
+    submit_cache.question = std::move(next_bundle);
+    // Cache through `state` before the push_back below can reallocate the
+    // questions vector and invalidate the reference.
+    state.cached_response = std::make_unique<SubmitCache>(std::move(submit_cache));
+    const std::size_t next_index = session.questions.size();
+    session.questions.push_back(std::move(next_state));
+    session.active_question = next_index;
+    return response;
   }
 
-  session.submit_cache[report.question_id] = submit_cache;
+  state.cached_response = std::make_unique<SubmitCache>(std::move(submit_cache));
   return response;
 }
 
@@ -13,6 +13,7 @@
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 #include <type_traits>
 #include <variant>
@@ -73,355 +74,400 @@ ear::AnswerKind answer_kind_from_string(const std::string& kind) {
   return ear::AnswerKind::ChordDegree;
 }
 
+nlohmann::json chord_question_json(const ear::ChordQuestionV2& q) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "chord";
+  json["tonic_midi"] = q.tonic_midi;
+  json["tonic"] = q.tonic;
+  json["key"] = ear::key_quality_to_string(q.key);
+  auto to_int_array = [](const std::vector<int>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int v : values) arr.push_back(v);
+    return arr;
+  };
+  auto to_quality_array = [](const std::vector<ear::TriadQuality>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (auto v : values) arr.push_back(triad_quality_to_string(v));
+    return arr;
+  };
+  auto to_optional_vec_array = [](const std::vector<std::optional<std::vector<int>>>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& opt : values) {
+      if (!opt.has_value()) {
+        arr.push_back(nullptr);
+      } else {
+        nlohmann::json inner = nlohmann::json::array();
+        for (int v : opt.value()) inner.push_back(v);
+        arr.push_back(std::move(inner));
+      }
+    }
+    return arr;
+  };
+  auto to_optional_array = [](const auto& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& opt : values) {
+      if (opt.has_value()) {
+        arr.push_back(opt.value());
+      } else {
+        arr.push_back(nullptr);
+      }
+    }
+    return arr;
+  };
+  auto to_bool_array = [](const std::vector<bool>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (bool v : values) arr.push_back(v);
+    return arr;
+  };
+  json["root_degrees"] = to_int_array(q.root_degrees);
+  json["qualities"] = to_quality_array(q.qualities);
+  json["rh_degrees"] = to_optional_vec_array(q.rh_degrees);
+  json["bass_degrees"] = to_optional_array(q.bass_degrees);
+  json["right_voicing_id"] = to_optional_array(q.right_voicing_ids);
+  json["bass_voicing_id"] = to_optional_array(q.bass_voicing_ids);
+  json["is_anchor"] = to_bool_array(q.is_anchor);
+  if (!q.root_degrees.empty()) {
+    json["root_degree"] = q.root_degrees.front();
+  }
+  if (!q.qualities.empty()) {
+    json["quality"] = triad_quality_to_string(q.qualities.front());
+  }
+  return json;
+}
+
+nlohmann::json melody_question_json(const ear::MelodyQuestionV2& q) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "melody";
+  json["tonic_midi"] = q.tonic_midi;
+  json["tonic"] = q.tonic;
+  json["key"] = ear::key_quality_to_string(q.key);
+  {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int d : q.melody) arr.push_back(d);
+    json["melody"] = std::move(arr);
+  }
+  if (q.octave.has_value()) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int d : q.octave.value()) arr.push_back(d);
+    json["octave"] = std::move(arr);
+  } else {
+    json["octave"] = nullptr;
+  }
+  if (q.helper.has_value()) {
+    json["helper"] = q.helper.value();
+  } else {
+    json["helper"] = nullptr;
+  }
+  return json;
+}
+
+nlohmann::json harmony_question_json(const ear::HarmonyQuestionV2& q) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "harmony";
+  json["tonic_midi"] = q.tonic_midi;
+  json["tonic"] = q.tonic;
+  json["key"] = ear::key_quality_to_string(q.key);
+  json["note_num"] = q.note_num;
+  {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int n : q.notes) arr.push_back(n);
+    json["notes"] = std::move(arr);
+  }
+  if (q.interval.has_value()) {
+    json["interval"] = q.interval.value();
+  } else {
+    json["interval"] = nullptr;
+  }
+  return json;
+}
+
 nlohmann::json question_payload_json(const ear::QuestionPayloadV2& payload) {
-  return std::visit(
-      [](const auto& q) -> nlohmann::json {
-        using T = std::decay_t<decltype(q)>;
-        nlohmann::json json = nlohmann::json::object();
-        if constexpr (std::is_same_v<T, ear::ChordQuestionV2>) {
-          json["type"] = "chord";
-          json["tonic_midi"] = q.tonic_midi;
-          json["tonic"] = q.tonic;
-          json["key"] = ear::key_quality_to_string(q.key);
-          auto to_int_array = [](const std::vector<int>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int v : values) arr.push_back(v);
-            return arr;
-          };
-          auto to_quality_array = [](const std::vector<ear::TriadQuality>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (auto v : values) arr.push_back(triad_quality_to_string(v));
-            return arr;
-          };
-          auto to_optional_vec_array = [](const std::vector<std::optional<std::vector<int>>>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& opt : values) {
-              if (!opt.has_value()) {
-                arr.push_back(nullptr);
-              } else {
-                nlohmann::json inner = nlohmann::json::array();
-                for (int v : opt.value()) inner.push_back(v);
-                arr.push_back(std::move(inner));
-              }
-            }
-            return arr;
-          };
-          auto to_optional_array = [](const auto& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& opt : values) {
-              if (opt.has_value()) {
-                arr.push_back(opt.value());
-              } else {
-                arr.push_back(nullptr);
-              }
-            }
-            return arr;
-          };
-          auto to_bool_array = [](const std::vector<bool>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (bool v : values) arr.push_back(v);
-            return arr;
-          };
-          json["root_degrees"] = to_int_array(q.root_degrees);
-          json["qualities"] = to_quality_array(q.qualities);
-          json["rh_degrees"] = to_optional_vec_array(q.rh_degrees);
-          json["bass_degrees"] = to_optional_array(q.bass_degrees);
-          json["right_voicing_id"] = to_optional_array(q.right_voicing_ids);
-          json["bass_voicing_id"] = to_optional_array(q.bass_voicing_ids);
-          json["is_anchor"] = to_bool_array(q.is_anchor);
-          if (!q.root_degrees.empty()) {
-            json["root_degree"] = q.root_degrees.front();
-          }
-          if (!q.qualities.empty()) {
-            json["quality"] = triad_quality_to_string(q.qualities.front());
-          }
-        } else if constexpr (std::is_same_v<T, ear::MelodyQuestionV2>) {
-          json["type"] = "melody";
-          json["tonic_midi"] = q.tonic_midi;
-          json["tonic"] = q.tonic;
-          json["key"] = ear::key_quality_to_string(q.key);
-          {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int d : q.melody) arr.push_back(d);
-            json["melody"] = std::move(arr);
-          }
-          if (q.octave.has_value()) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int d : q.octave.value()) arr.push_back(d);
-            json["octave"] = std::move(arr);
-          } else {
-            json["octave"] = nullptr;
-          }
-          if (q.helper.has_value()) {
-            json["helper"] = q.helper.value();
-          } else {
-            json["helper"] = nullptr;
-          }
-        } else if constexpr (std::is_same_v<T, ear::HarmonyQuestionV2>) {
-          json["type"] = "harmony";
-          json["tonic_midi"] = q.tonic_midi;
-          json["tonic"] = q.tonic;
-          json["key"] = ear::key_quality_to_string(q.key);
-          json["note_num"] = q.note_num;
-          {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int n : q.notes) arr.push_back(n);
-            json["notes"] = std::move(arr);
-          }
-          if (q.interval.has_value()) {
-            json["interval"] = q.interval.value();
-          } else {
-            json["interval"] = nullptr;
-          }
-        }
-        return json;
-      },
-      payload);
+  // Index switch in place of std::visit, mirroring the encoders in
+  // json_bridge.cpp: each alternative serializes through its own function.
+  switch (payload.index()) {
+    case 0: return chord_question_json(std::get<0>(payload));
+    case 1: return melody_question_json(std::get<1>(payload));
+    default: return harmony_question_json(std::get<2>(payload));
+  }
 }
 
 nlohmann::json answer_payload_json(const ear::AnswerPayloadV2& payload);
 
-ear::QuestionPayloadV2 question_payload_from_json(const nlohmann::json& json) {
-  const std::string type = json["type"].get<std::string>();
-  if (type == "chord") {
-    ear::ChordQuestionV2 q;
-    q.tonic_midi = json["tonic_midi"].get<int>();
-    q.tonic = json["tonic"].get<std::string>();
-    q.key = key_quality_from_string(json["key"].get<std::string>());
-
-    auto parse_int_array = [&](const char* key) {
-      std::vector<int> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) values.push_back(el.get<int>());
-      }
-      return values;
-    };
-    auto parse_quality_array = [&]() {
-      std::vector<ear::TriadQuality> values;
-      if (json.contains("qualities") && json["qualities"].is_array()) {
-        for (const auto& el : json["qualities"].get_array()) {
-          values.push_back(triad_quality_from_string(el.get<std::string>()));
-        }
-      }
-      return values;
-    };
-    auto parse_optional_vec_array = [&](const char* key) {
-      std::vector<std::optional<std::vector<int>>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) {
-          if (el.is_null()) {
-            values.push_back(std::nullopt);
-          } else {
-            std::vector<int> inner;
-            for (const auto& inner_el : el.get_array()) inner.push_back(inner_el.get<int>());
-            values.push_back(std::move(inner));
-          }
-        }
-      }
-      return values;
-    };
-    auto parse_optional_array = [&](const char* key) {
-      std::vector<std::optional<int>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) {
-          values.push_back(el.is_null() ? std::optional<int>() : std::optional<int>(el.get<int>()));
-        }
+ear::ChordQuestionV2 chord_question_from_json(const nlohmann::json& json) {
+  ear::ChordQuestionV2 q;
+  q.tonic_midi = json["tonic_midi"].get<int>();
+  q.tonic = json["tonic"].get<std::string>();
+  q.key = key_quality_from_string(json["key"].get<std::string>());
+
+  auto parse_int_array = [&](const char* key) {
+    std::vector<int> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) values.push_back(el.get<int>());
+    }
+    return values;
+  };
+  auto parse_quality_array = [&]() {
+    std::vector<ear::TriadQuality> values;
+    if (json.contains("qualities") && json["qualities"].is_array()) {
+      for (const auto& el : json["qualities"].get_array()) {
+        values.push_back(triad_quality_from_string(el.get<std::string>()));
       }
-      return values;
-    };
-    auto parse_optional_string_array = [&](const char* key) {
-      std::vector<std::optional<std::string>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) {
-          values.push_back(el.is_null() ? std::optional<std::string>() : std::optional<std::string>(el.get<std::string>()));
+    }
+    return values;
+  };
+  auto parse_optional_vec_array = [&](const char* key) {
+    std::vector<std::optional<std::vector<int>>> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) {
+        if (el.is_null()) {
+          values.push_back(std::nullopt);
+        } else {
+          std::vector<int> inner;
+          for (const auto& inner_el : el.get_array()) inner.push_back(inner_el.get<int>());
+          values.push_back(std::move(inner));
         }
       }
-      return values;
-    };
-    auto parse_bool_array = [&](const char* key) {
-      std::vector<bool> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) values.push_back(el.get<bool>());
-      }
-      return values;
-    };
-
-    q.root_degrees = parse_int_array("root_degrees");
-    if (q.root_degrees.empty()) {
-      q.root_degrees.push_back(json["root_degree"].get<int>());
-    }
-    q.qualities = parse_quality_array();
-    if (q.qualities.empty()) {
-      q.qualities.push_back(triad_quality_from_string(json["quality"].get<std::string>()));
     }
-    std::size_t len = q.root_degrees.size();
-    auto ensure_size = [&](auto vec, auto default_value) {
-      if (vec.size() < len) vec.resize(len, default_value);
-      return vec;
-    };
-    q.rh_degrees = ensure_size(parse_optional_vec_array("rh_degrees"), std::optional<std::vector<int>>{});
-    q.bass_degrees = ensure_size(parse_optional_array("bass_degrees"), std::optional<int>{});
-    q.right_voicing_ids = ensure_size(parse_optional_string_array("right_voicing_id"), std::optional<std::string>{});
-    q.bass_voicing_ids = ensure_size(parse_optional_string_array("bass_voicing_id"), std::optional<std::string>{});
-    q.is_anchor = ensure_size(parse_bool_array("is_anchor"), false);
-    return q;
-  }
-  if (type == "melody") {
-    ear::MelodyQuestionV2 q;
-    q.tonic_midi = json["tonic_midi"].get<int>();
-    q.tonic = json["tonic"].get<std::string>();
-    q.key = key_quality_from_string(json["key"].get<std::string>());
-    q.melody.clear();
-    if (json["melody"].is_array()) {
-      for (const auto& el : json["melody"].get_array()) q.melody.push_back(el.get<int>());
+    return values;
+  };
+  auto parse_optional_array = [&](const char* key) {
+    std::vector<std::optional<int>> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) {
+        values.push_back(el.is_null() ? std::optional<int>() : std::optional<int>(el.get<int>()));
+      }
     }
-    if (!json["octave"].is_null()) {
-      std::vector<int> vals;
-      if (json["octave"].is_array()) {
-        for (const auto& el : json["octave"].get_array()) vals.push_back(el.get<int>());
+    return values;
+  };
+  auto parse_optional_string_array = [&](const char* key) {
+    std::vector<std::optional<std::string>> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) {
+        values.push_back(el.is_null() ? std::optional<std::string>() : std::optional<std::string>(el.get<std::string>()));
       }
-      q.octave = std::move(vals);
     }
-    if (!json["helper"].is_null()) {
-      q.helper = json["helper"].get<std::string>();
+    return values;
+  };
+  auto parse_bool_array = [&](const char* key) {
+    std::vector<bool> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) values.push_back(el.get<bool>());
     }
-    return q;
-  }
-  if (type == "harmony") {
-    ear::HarmonyQuestionV2 q;
-    q.tonic_midi = json["tonic_midi"].get<int>();
-    q.tonic = json["tonic"].get<std::string>();
-    q.key = key_quality_from_string(json["key"].get<std::string>());
-    q.note_num = json["note_num"].get<int>();
-    q.notes.clear();
-    if (json["notes"].is_array()) {
-      for (const auto& el : json["notes"].get_array()) q.notes.push_back(el.get<int>());
+    return values;
+  };
+
+  q.root_degrees = parse_int_array("root_degrees");
+  if (q.root_degrees.empty()) {
+    q.root_degrees.push_back(json["root_degree"].get<int>());
+  }
+  q.qualities = parse_quality_array();
+  if (q.qualities.empty()) {
+    q.qualities.push_back(triad_quality_from_string(json["quality"].get<std::string>()));
+  }
+  std::size_t len = q.root_degrees.size();
+  auto ensure_size = [&](auto vec, auto default_value) {
+    if (vec.size() < len) vec.resize(len, default_value);
+    return vec;
+  };
+  q.rh_degrees = ensure_size(parse_optional_vec_array("rh_degrees"), std::optional<std::vector<int>>{});
+  q.bass_degrees = ensure_size(parse_optional_array("bass_degrees"), std::optional<int>{});
+  q.right_voicing_ids = ensure_size(parse_optional_string_array("right_voicing_id"), std::optional<std::string>{});
+  q.bass_voicing_ids = ensure_size(parse_optional_string_array("bass_voicing_id"), std::optional<std::string>{});
+  q.is_anchor = ensure_size(parse_bool_array("is_anchor"), false);
+  return q;
+}
+
+ear::MelodyQuestionV2 melody_question_from_json(const nlohmann::json& json) {
+  ear::MelodyQuestionV2 q;
+  q.tonic_midi = json["tonic_midi"].get<int>();
+  q.tonic = json["tonic"].get<std::string>();
+  q.key = key_quality_from_string(json["key"].get<std::string>());
+  q.melody.clear();
+  if (json["melody"].is_array()) {
+    for (const auto& el : json["melody"].get_array()) q.melody.push_back(el.get<int>());
+  }
+  if (!json["octave"].is_null()) {
+    std::vector<int> vals;
+    if (json["octave"].is_array()) {
+      for (const auto& el : json["octave"].get_array()) vals.push_back(el.get<int>());
     }
-    if (!json["interval"].is_null()) {
-      q.interval = json["interval"].get<std::string>();
+    q.octave = std::move(vals);
+  }
+  if (!json["helper"].is_null()) {
+    q.helper = json["helper"].get<std::string>();
+  }
+  return q;
+}
+
+ear::HarmonyQuestionV2 harmony_question_from_json(const nlohmann::json& json) {
+  ear::HarmonyQuestionV2 q;
+  q.tonic_midi = json["tonic_midi"].get<int>();
+  q.tonic = json["tonic"].get<std::string>();
+  q.key = key_quality_from_string(json["key"].get<std::string>());
+  q.note_num = json["note_num"].get<int>();
+  q.notes.clear();
+  if (json["notes"].is_array()) {
+    for (const auto& el : json["notes"].get_array()) q.notes.push_back(el.get<int>());
+  }
+  if (!json["interval"].is_null()) {
+    q.interval = json["interval"].get<std::string>();
+  }
+  return q;
+}
+
+ear::QuestionPayloadV2 question_payload_from_json(const nlohmann::json& json) {
+  const std::string_view type = json["type"].get_string();
+  // Tag lengths are distinct, so the length picks the sole candidate and a
+  // single comparison confirms it - the keying json_bridge.cpp uses - with
+  // no std::string materialized for the comparisons.
+  switch (type.size()) {
+    case 5: if (type == "chord") return chord_question_from_json(json); break;
+    case 6: if (type == "melody") return melody_question_from_json(json); break;
+    case 7: if (type == "harmony") return harmony_question_from_json(json); break;
+    default: break;
+  }
+  throw std::runtime_error(std::string("Unknown question payload type: ").append(type));
+}
+
+nlohmann::json chord_answer_json(const ear::ChordAnswerV2& a) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "chord";
+  auto to_int_array = [](const std::vector<int>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int v : values) arr.push_back(v);
+    return arr;
+  };
+  auto to_optional_array = [](const std::vector<std::optional<int>>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (const auto& opt : values) {
+      arr.push_back(opt.has_value() ? nlohmann::json(opt.value()) : nlohmann::json(nullptr));
     }
-    return q;
+    return arr;
+  };
+  auto to_bool_array = [](const std::vector<bool>& values) {
+    nlohmann::json arr = nlohmann::json::array();
+    for (bool v : values) arr.push_back(v);
+    return arr;
+  };
+  json["root_degrees"] = to_int_array(a.root_degrees);
+  json["bass_deg"] = to_optional_array(a.bass_deg);
+  json["top_deg"] = to_optional_array(a.top_deg);
+  json["expect_root"] = to_bool_array(a.expect_root);
+  json["expect_bass"] = to_bool_array(a.expect_bass);
+  json["expect_top"] = to_bool_array(a.expect_top);
+  if (!a.root_degrees.empty()) {
+    json["root_degree"] = a.root_degrees.front();
   }
-  throw std::runtime_error("Unknown question payload type: " + type);
+  return json;
+}
+
+nlohmann::json melody_answer_json(const ear::MelodyAnswerV2& a) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "melody";
+  {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int d : a.melody) arr.push_back(d);
+    json["melody"] = std::move(arr);
+  }
+  return json;
+}
+
+nlohmann::json harmony_answer_json(const ear::HarmonyAnswerV2& a) {
+  nlohmann::json json = nlohmann::json::object();
+  json["type"] = "harmony";
+  {
+    nlohmann::json arr = nlohmann::json::array();
+    for (int n : a.notes) arr.push_back(n);
+    json["notes"] = std::move(arr);
+  }
+  return json;
 }
 
 nlohmann::json answer_payload_json(const ear::AnswerPayloadV2& payload) {
-  return std::visit(
-      [](const auto& a) -> nlohmann::json {
-        using T = std::decay_t<decltype(a)>;
-        nlohmann::json json = nlohmann::json::object();
-        if constexpr (std::is_same_v<T, ear::ChordAnswerV2>) {
-          json["type"] = "chord";
-          auto to_int_array = [](const std::vector<int>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int v : values) arr.push_back(v);
-            return arr;
-          };
-          auto to_optional_array = [](const std::vector<std::optional<int>>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (const auto& opt : values) {
-              arr.push_back(opt.has_value() ? nlohmann::json(opt.value()) : nlohmann::json(nullptr));
-            }
-            return arr;
-          };
-          auto to_bool_array = [](const std::vector<bool>& values) {
-            nlohmann::json arr = nlohmann::json::array();
-            for (bool v : values) arr.push_back(v);
-            return arr;
-          };
-          json["root_degrees"] = to_int_array(a.root_degrees);
-          json["bass_deg"] = to_optional_array(a.bass_deg);
-          json["top_deg"] = to_optional_array(a.top_deg);
-          json["expect_root"] = to_bool_array(a.expect_root);
-          json["expect_bass"] = to_bool_array(a.expect_bass);
-          json["expect_top"] = to_bool_array(a.expect_top);
-          if (!a.root_degrees.empty()) {
-            json["root_degree"] = a.root_degrees.front();
-          }
-        } else if constexpr (std::is_same_v<T, ear::MelodyAnswerV2>) {
-          json["type"] = "melody";
-          {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int d : a.melody) arr.push_back(d);
-            json["melody"] = std::move(arr);
-          }
-        } else if constexpr (std::is_same_v<T, ear::HarmonyAnswerV2>) {
-          json["type"] = "harmony";
-          {
-            nlohmann::json arr = nlohmann::json::array();
-            for (int n : a.notes) arr.push_back(n);
-            json["notes"] = std::move(arr);
-          }
-        }
-        return json;
-      },
-      payload);
+  // Same index-switch dispatch as the question encoder above.
+  switch (payload.index()) {
+    case 0: return chord_answer_json(std::get<0>(payload));
+    case 1: return melody_answer_json(std::get<1>(payload));
+    default: return harmony_answer_json(std::get<2>(payload));
+  }
 }
 
-ear::AnswerPayloadV2 answer_payload_from_json(const nlohmann::json& json) {
-  const std::string type = json["type"].get<std::string>();
-  if (type == "chord") {
-    ear::ChordAnswerV2 answer;
-    auto parse_int_array = [&](const char* key) {
-      std::vector<int> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) values.push_back(el.get<int>());
-      }
-      return values;
-    };
-    auto parse_optional_array = [&](const char* key) {
-      std::vector<std::optional<int>> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) {
-          values.push_back(el.is_null() ? std::optional<int>() : std::optional<int>(el.get<int>()));
-        }
-      }
-      return values;
-    };
-    auto parse_bool_array = [&](const char* key) {
-      std::vector<bool> values;
-      if (json.contains(key) && json[key].is_array()) {
-        for (const auto& el : json[key].get_array()) values.push_back(el.get<bool>());
-      }
-      return values;
-    };
-    answer.root_degrees = parse_int_array("root_degrees");
-    if (answer.root_degrees.empty()) {
-      answer.root_degrees.push_back(json["root_degree"].get<int>());
+ear::ChordAnswerV2 chord_answer_from_json(const nlohmann::json& json) {
+  ear::ChordAnswerV2 answer;
+  auto parse_int_array = [&](const char* key) {
+    std::vector<int> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) values.push_back(el.get<int>());
     }
-    std::size_t len = answer.root_degrees.size();
-    auto ensure_size = [&](auto vec, auto default_value) {
-      if (vec.size() < len) vec.resize(len, default_value);
-      return vec;
-    };
-    answer.bass_deg = ensure_size(parse_optional_array("bass_deg"), std::optional<int>{});
-    answer.top_deg = ensure_size(parse_optional_array("top_deg"), std::optional<int>{});
-    answer.expect_root = ensure_size(parse_bool_array("expect_root"), true);
-    answer.expect_bass = ensure_size(parse_bool_array("expect_bass"), false);
-    answer.expect_top = ensure_size(parse_bool_array("expect_top"), true);
-    return answer;
-  }
-  if (type == "melody") {
-    ear::MelodyAnswerV2 answer;
-    answer.melody.clear();
-    if (json["melody"].is_array()) {
-      for (const auto& el : json["melody"].get_array()) {
-        answer.melody.push_back(el.get<int>());
+    return values;
+  };
+  auto parse_optional_array = [&](const char* key) {
+    std::vector<std::optional<int>> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) {
+        values.push_back(el.is_null() ? std::optional<int>() : std::optional<int>(el.get<int>()));
       }
     }
-    return answer;
-  }
-  if (type == "harmony") {
-    ear::HarmonyAnswerV2 answer;
-    answer.notes.clear();
-    if (json["notes"].is_array()) {
-      for (const auto& el : json["notes"].get_array()) {
-        answer.notes.push_back(el.get<int>());
-      }
+    return values;
+  };
+  auto parse_bool_array = [&](const char* key) {
+    std::vector<bool> values;
+    if (json.contains(key) && json[key].is_array()) {
+      for (const auto& el : json[key].get_array()) values.push_back(el.get<bool>());
+    }
+    return values;
+  };
+  answer.root_degrees = parse_int_array("root_degrees");
+  if (answer.root_degrees.empty()) {
+    answer.root_degrees.push_back(json["root_degree"].get<int>());
+  }
+  std::size_t len = answer.root_degrees.size();
+  auto ensure_size = [&](auto vec, auto default_value) {
+    if (vec.size() < len) vec.resize(len, default_value);
+    return vec;
+  };
+  answer.bass_deg = ensure_size(parse_optional_array("bass_deg"), std::optional<int>{});
+  answer.top_deg = ensure_size(parse_optional_array("top_deg"), std::optional<int>{});
+  answer.expect_root = ensure_size(parse_bool_array("expect_root"), true);
+  answer.expect_bass = ensure_size(parse_bool_array("expect_bass"), false);
+  answer.expect_top = ensure_size(parse_bool_array("expect_top"), true);
+  return answer;
+}
+
+ear::MelodyAnswerV2 melody_answer_from_json(const nlohmann::json& json) {
+  ear::MelodyAnswerV2 answer;
+  answer.melody.clear();
+  if (json["melody"].is_array()) {
+    for (const auto& el : json["melody"].get_array()) {
+      answer.melody.push_back(el.get<int>());
+    }
+  }
+  return answer;
+}
+
+ear::HarmonyAnswerV2 harmony_answer_from_json(const nlohmann::json& json) {
+  ear::HarmonyAnswerV2 answer;
+  answer.notes.clear();
+  if (json["notes"].is_array()) {
+    for (const auto& el : json["notes"].get_array()) {
+      answer.notes.push_back(el.get<int>());
     }
-    return answer;
   }
-  throw std::runtime_error("Unknown answer payload type: " + type);
+  return answer;
+}
+
+ear::AnswerPayloadV2 answer_payload_from_json(const nlohmann::json& json) {
+  const std::string_view type = json["type"].get_string();
+  // Tag lengths are distinct, so the length picks the sole candidate and a
+  // single comparison confirms it - the keying json_bridge.cpp uses - with
+  // no std::string materialized for the comparisons.
+  switch (type.size()) {
+    case 5: if (type == "chord") return chord_answer_from_json(json); break;
+    case 6: if (type == "melody") return melody_answer_from_json(json); break;
+    case 7: if (type == "harmony") return harmony_answer_from_json(json); break;
+    default: break;
+  }
+  throw std::runtime_error(std::string("Unknown answer payload type: ").append(type));
 }
 
 nlohmann::json ui_hints_json(const std::optional<ear::UiHintsV2>& hints) {
@@ -467,21 +513,26 @@ ear::MidiClip midi_clip_from_json(const nlohmann::json& json) {
       track.channel = track_json["channel"].get<int>();
       track.program = track_json["program"].get<int>();
       if (track_json.contains("events") && track_json["events"].is_array()) {
-        for (const auto& event_json : track_json["events"].get_array()) {
+        const auto& events = track_json["events"].get_array();
+        track.events.reserve(events.size());
+        for (const auto& event_json : events) {
           ear::MidiEvent event;
-          event.t = event_json["t"].get<int>();
-          event.type = event_json["type"].get<std::string>();
-          if (event_json.contains("note")) {
-            event.note = event_json["note"].get<int>();
-          }
-          if (event_json.contains("vel")) {
-            event.vel = event_json["vel"].get<int>();
-          }
-          if (event_json.contains("control")) {
-            event.control = event_json["control"].get<int>();
-          }
-          if (event_json.contains("value")) {
-            event.value = event_json["value"].get<int>();
+          // One walk over the event's members instead of a contains() probe
+          // per optional field, like the parse loops in json_bridge.cpp.
+          for (const auto& [key, value] : event_json.get_object()) {
+            if (key == "t") {
+              event.t = value.get<int>();
+            } else if (key == "type") {
+              event.type = ear::midi_event_type_from_string(value.get<std::string>());
+            } else if (key == "note") {
+              event.note = value.get<int>();
+            } else if (key == "vel") {
+              event.vel = value.get<int>();
+            } else if (key == "control") {
+              event.control = value.get<int>();
+            } else if (key == "value") {
+              event.value = value.get<int>();
+            }
           }
           track.events.push_back(event);
         }